@@ -0,0 +1,2 @@
+// Adafruit_GFX.h (host)
+#include <Arduino.h>
@@ -0,0 +1,3 @@
+// Adafruit_SSD1306.h (host): OLED.h only holds a pointer to the display
+#include <Arduino.h>
+class Adafruit_SSD1306;
@@ -0,0 +1,91 @@
+// Arduino.h (host)
+//
+// Just enough of the Teensy core for the OSC ingest sources to build on Linux.
+// Time comes from a fake clock the harness advances (host_stubs.cpp).
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define PI 3.14159265358979
+#define F(x) (x)
+#define DMAMEM
+#define FASTRUN
+#define FLASHMEM
+#define PROGMEM
+
+using std::min;
+using std::max;
+
+template <class T, class L, class H>
+auto constrain(T x, L lo, H hi) -> decltype(x + lo + hi) {
+  return x < lo ? lo : (x > hi ? hi : x);
+}
+
+class String;   // Only named in declarations the ingest path never calls
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) { return 1; }
+  virtual size_t write(const uint8_t*, size_t n) { return n; }
+  size_t print(const char*) { return 0; }
+  size_t print(char) { return 0; }
+  size_t print(int, int = 10) { return 0; }
+  size_t print(unsigned, int = 10) { return 0; }
+  size_t print(long, int = 10) { return 0; }
+  size_t print(unsigned long, int = 10) { return 0; }
+  size_t print(double, int = 2) { return 0; }
+  size_t println() { return 0; }
+  template <class T> size_t println(T v) { return print(v); }
+  int printf(const char*, ...) { return 0; }
+  virtual void flush() {}
+};
+
+class Printable {
+ public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print& p) const = 0;
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  virtual int peek() { return -1; }
+};
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+void noInterrupts();
+void interrupts();
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+uint32_t htonl(uint32_t v);
+uint16_t htons(uint16_t v);
+uint32_t ntohl(uint32_t v);
+uint16_t ntohs(uint16_t v);
+
+class elapsedMicros {
+ public:
+  elapsedMicros() : start(micros()) {}
+  operator uint32_t() const { return micros() - start; }
+
+ private:
+  uint32_t start;
+};
+
+#endif  // HOST_ARDUINO_H
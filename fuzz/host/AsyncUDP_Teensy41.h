@@ -0,0 +1,33 @@
+// AsyncUDP_Teensy41.h (host)
+//
+// Sends are counted and dropped; the harness feeds input through queueIncomingOsc().
+
+#ifndef HOST_ASYNCUDP_H
+#define HOST_ASYNCUDP_H
+
+#include <QNEthernet.h>
+#include <functional>
+
+class AsyncUDPPacket {
+ public:
+  uint8_t* data() { return nullptr; }
+  size_t length() { return 0; }
+  IPAddress remoteIP() { return IPAddress(); }
+  uint16_t remotePort() { return 0; }
+};
+
+class AsyncUDP {
+ public:
+  bool listen(uint16_t) { return true; }
+  bool listenMulticast(const IPAddress&, uint16_t, uint8_t = 1) { return true; }
+  void close() {}
+  void onPacket(std::function<void(AsyncUDPPacket&)>) {}
+  size_t writeTo(const uint8_t*, size_t len, const IPAddress&, uint16_t) {
+    bytesSent += len;
+    return len;
+  }
+
+  size_t bytesSent = 0;
+};
+
+#endif  // HOST_ASYNCUDP_H
@@ -0,0 +1,31 @@
+// IPAddress.h (host)
+#ifndef HOST_IPADDRESS_H
+#define HOST_IPADDRESS_H
+
+#include <Arduino.h>
+
+class IPAddress {
+ public:
+  IPAddress() : bytes{0, 0, 0, 0} {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+  explicit IPAddress(uint32_t v) {
+    memcpy(bytes, &v, 4);
+  }
+
+  uint8_t operator[](int i) const { return bytes[i]; }
+  uint8_t& operator[](int i) { return bytes[i]; }
+  operator uint32_t() const {
+    uint32_t v;
+    memcpy(&v, bytes, 4);
+    return v;
+  }
+  bool operator==(const IPAddress& o) const { return memcmp(bytes, o.bytes, 4) == 0; }
+  bool operator!=(const IPAddress& o) const { return !(*this == o); }
+
+ private:
+  uint8_t bytes[4];
+};
+
+extern const IPAddress INADDR_NONE;
+
+#endif  // HOST_IPADDRESS_H
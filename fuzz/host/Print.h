@@ -0,0 +1,2 @@
+// Print.h (host)
+#include <Arduino.h>
@@ -0,0 +1,2 @@
+// Printable.h (host)
+#include <Arduino.h>
@@ -0,0 +1,53 @@
+// QNEthernet.h (host)
+//
+// The link is always up with a fixed address; nothing goes on the wire.
+
+#ifndef HOST_QNETHERNET_H
+#define HOST_QNETHERNET_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <functional>
+
+namespace qindesign {
+namespace network {
+
+class EthernetClass {
+ public:
+  bool begin() { return true; }
+  bool begin(const IPAddress&, const IPAddress&, const IPAddress&) { return true; }
+  void end() {}
+  void loop() {}
+  bool linkState() { return true; }
+  IPAddress localIP() { return IPAddress(192, 168, 0, 169); }
+  IPAddress subnetMask() { return IPAddress(255, 255, 255, 0); }
+  IPAddress gatewayIP() { return IPAddress(192, 168, 0, 1); }
+  void macAddress(uint8_t mac[6]) {
+    static const uint8_t kMac[6] = {0x04, 0xE9, 0xE5, 0x12, 0x34, 0x56};
+    memcpy(mac, kMac, 6);
+  }
+  void setHostname(const char*) {}
+  bool joinGroup(const IPAddress&) { return true; }
+  bool leaveGroup(const IPAddress&) { return true; }
+  void onLinkState(std::function<void(bool)>) {}
+  void onAddressChanged(std::function<void()>) {}
+  bool setDHCPEnabled(bool) { return true; }
+  bool renewDHCP() { return true; }
+};
+
+class MDNSClass {
+ public:
+  bool begin(const char*) { return true; }
+  bool addService(const char*, const char*, uint16_t) { return true; }
+  bool removeService(const char*, const char*, uint16_t) { return true; }
+  bool restart() { return true; }
+  void end() {}
+};
+
+extern EthernetClass Ethernet;
+extern MDNSClass MDNS;
+
+}  // namespace network
+}  // namespace qindesign
+
+#endif  // HOST_QNETHERNET_H
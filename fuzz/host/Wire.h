@@ -0,0 +1,2 @@
+// Wire.h (host)
+#include <Arduino.h>
@@ -0,0 +1,138 @@
+// host_stubs.cpp
+//
+// Everything the OSC ingest sources call outside NetworkOSC, ExecutorStatus, PageCache,
+// ConsoleLink and Config: a fake clock, silent logging, and fader/LED/TCP hooks that
+// do nothing beyond keeping the fader setpoints.
+
+#include "host_stubs.h"
+#include "Config.h"
+#include "FaderControl.h"
+#include "KeyLedControl.h"
+#include "NetworkOSC.h"
+#include "OLED.h"
+#include "OscTcp.h"
+#include <stdarg.h>
+
+//================================
+// CLOCK
+//================================
+
+static uint64_t fakeMicros = 1000000;   // Start past the boot-time windows
+
+uint32_t millis() { return (uint32_t)(fakeMicros / 1000); }
+uint32_t micros() { return (uint32_t)fakeMicros; }
+void delay(uint32_t ms) { fakeMicros += (uint64_t)ms * 1000; }
+void delayMicroseconds(uint32_t us) { fakeMicros += us; }
+void yield() {}
+void noInterrupts() {}
+void interrupts() {}
+
+void hostAdvanceMillis(uint32_t ms) {
+  fakeMicros += (uint64_t)ms * 1000;
+}
+
+void hostAdvanceMicros(uint32_t us) {
+  fakeMicros += us;
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+uint32_t htonl(uint32_t v) { return __builtin_bswap32(v); }
+uint16_t htons(uint16_t v) { return __builtin_bswap16(v); }
+uint32_t ntohl(uint32_t v) { return __builtin_bswap32(v); }
+uint16_t ntohs(uint16_t v) { return __builtin_bswap16(v); }
+
+//================================
+// NETWORK
+//================================
+
+const IPAddress INADDR_NONE(0, 0, 0, 0);
+
+namespace qindesign {
+namespace network {
+EthernetClass Ethernet;
+MDNSClass MDNS;
+}  // namespace network
+}  // namespace qindesign
+
+bool oscTcpQueueMessage(const uint8_t*, size_t, const IPAddress&) {
+  return false;   // UDP transport
+}
+
+//================================
+// DISPLAY AND LOGGING
+//================================
+
+class Adafruit_SSD1306 {};
+
+OLED::OLED() : i2cAddress(0), displayInitialized(false) {}
+OLED::~OLED() {}
+void OLED::display() {}
+void OLED::showStatus(const char*) {}
+
+OLED display;
+
+void displayIPAddress() {}
+
+static bool hostVerbose() {
+  static const bool verbose = getenv("FUZZ_VERBOSE") != nullptr;
+  return verbose;
+}
+
+void debugPrint(const char* message) {
+  if (hostVerbose()) {
+    fprintf(stderr, "%s\n", message);
+  }
+}
+
+void debugPrintf(const char* format, ...) {
+  if (hostVerbose()) {
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+  }
+}
+
+//================================
+// FADERS AND KEY LEDS
+//================================
+
+void hostResetFaders() {
+  for (int i = 0; i < NUM_FADERS; i++) {
+    faders[i] = Fader{};
+    faders[i].oscID = OSC_IDS[i];
+    faders[i].lastSentOscValue = 255;   // Never written, as after initializeFaders()
+  }
+}
+
+int getFaderIndexFromID(int id) {
+  for (int i = 0; i < NUM_FADERS; i++) {
+    if (faders[i].oscID == id) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void setFaderSetpoint(int faderIndex, int oscValue) {
+  if (faderIndex >= 0 && faderIndex < NUM_FADERS) {
+    faders[faderIndex].setpoint = constrain(oscValue, 0, 100);
+  }
+}
+
+// The motors are where the setpoint says
+int readFadertoOSC(Fader& f) {
+  return f.setpoint;
+}
+
+void moveAllFadersToSetpoints() {}
+
+bool isStaleFaderEcho(Fader&, int, int) {
+  return false;
+}
+
+void markKeyLedDirty(int) {}
+void markKeyLedsDirty() {}
@@ -0,0 +1,11 @@
+// host_stubs.h
+#ifndef HOST_STUBS_H
+#define HOST_STUBS_H
+
+#include <Arduino.h>
+
+void hostAdvanceMillis(uint32_t ms);
+void hostAdvanceMicros(uint32_t us);
+void hostResetFaders();
+
+#endif  // HOST_STUBS_H
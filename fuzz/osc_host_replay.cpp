@@ -0,0 +1,109 @@
+// osc_host_replay.cpp
+//
+// Replays a recording through the firmware's OSC ingest path on a PC, with the same host
+// build as the fuzzer. osc_traffic_tool.py host-replay writes the input and runs this:
+//
+//   record = microseconds since the previous packet (4 bytes, big endian)
+//          | length (2 bytes, big endian) | packet
+//
+// Packets arrive from the primary console on the recorded schedule; processOscQueue()
+// runs every HOST_LOOP_US of simulated time in between, like the main loop. Prints the
+// firmware's receive counters and the host CPU time spent handling the packets.
+
+#include "host_stubs.h"
+#include "Config.h"
+#include "NetworkOSC.h"
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+static constexpr uint32_t HOST_LOOP_US = 1000;   // Main loop period while idle
+static constexpr uint16_t CONSOLE_PORT = 9000;
+
+static const IPAddress PRIMARY_CONSOLE(192, 168, 0, 10);   // netConfig.sendToIP default
+
+static double totalHandleUs = 0;
+static double worstHandleUs = 0;
+
+static void timedPass() {
+  const auto start = std::chrono::steady_clock::now();
+  processOscQueue();
+  const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  totalHandleUs += us;
+  if (us > worstHandleUs) worstHandleUs = us;
+}
+
+static bool readRecording(const char* path, std::vector<uint8_t>& out) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    out.insert(out.end(), buf, buf + n);
+  }
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s replay.bin\n", argv[0]);
+    return 2;
+  }
+  std::vector<uint8_t> data;
+  if (!readRecording(argv[1], data)) {
+    fprintf(stderr, "%s: cannot read\n", argv[1]);
+    return 2;
+  }
+
+  hostResetFaders();
+  uint32_t packets = 0;
+  uint32_t untilPassUs = HOST_LOOP_US;
+  size_t pos = 0;
+  while (pos + 6 <= data.size()) {
+    uint32_t gapUs = ((uint32_t)data[pos] << 24) | ((uint32_t)data[pos + 1] << 16) |
+                     ((uint32_t)data[pos + 2] << 8) | data[pos + 3];
+    const size_t len = ((size_t)data[pos + 4] << 8) | data[pos + 5];
+    pos += 6;
+    if (len > data.size() - pos) {
+      fprintf(stderr, "Truncated record at packet %u\n", (unsigned)packets);
+      return 2;
+    }
+
+    while (gapUs >= untilPassUs) {
+      hostAdvanceMicros(untilPassUs);
+      gapUs -= untilPassUs;
+      timedPass();
+      untilPassUs = HOST_LOOP_US;
+    }
+    hostAdvanceMicros(gapUs);
+    untilPassUs -= gapUs;
+    queueIncomingOsc(data.data() + pos, len, PRIMARY_CONSOLE, CONSOLE_PORT);
+    pos += len;
+    packets++;
+  }
+  for (int i = 0; i < 10; i++) {
+    hostAdvanceMicros(HOST_LOOP_US);
+    timedPass();
+  }
+
+  OscRxStats stats;
+  getOscRxStats(stats);
+  printf("[HOST] %u packets replayed, %u received by the firmware\n", (unsigned)packets, (unsigned)stats.received);
+  for (uint8_t t = 0; t < OSC_MSG_TYPE_COUNT; t++) {
+    printf("[HOST]   %-8s %u\n", oscMsgTypeName(t), (unsigned)stats.handled[t]);
+  }
+  printf("[HOST] Queue drops %u, oversize %u, coalesced colors %u, stale colors %u\n",
+         (unsigned)stats.queueDrops, (unsigned)stats.oversizeDrops, (unsigned)stats.colorCoalesced, (unsigned)stats.colorStale);
+  printf("[HOST] Parse failures %u, malformed %u, queue high water %u\n",
+         (unsigned)stats.parseFailures, (unsigned)stats.malformed, (unsigned)stats.queueHighWater);
+  printf("[HOST] Handling %.1f us per packet, worst pass %.1f us (host CPU)\n",
+         packets ? totalHandleUs / packets : 0.0, worstHandleUs);
+  printf("[HOST] Final page %d, fader setpoints", currentOSCPage);
+  for (int i = 0; i < NUM_FADERS; i++) {
+    printf(" %d", faders[i].setpoint);
+  }
+  printf("\n");
+  return 0;
+}
@@ -0,0 +1,76 @@
+// osc_ingest_fuzzer.cpp
+//
+// libFuzzer entry point for the OSC ingest path: queueIncomingOsc() -> processOscQueue()
+// -> LiteOSCParser -> handleBundledExecutorUpdate() / handleColorUpdate() (color string
+// parsing) / page changes / heartbeat and pong handling, built from the firmware sources.
+//
+// An input is a short sequence of UDP packets, so page changes, coalesced color bundles
+// and console failover are reachable:
+//
+//   record = flags (1 byte) | length (2 bytes, big endian) | packet
+//   flags  = bits 0-1 sender: 0 primary console, 1 backup console, 2-3 unknown host
+//            bits 2-7 time since the previous packet, in 50 ms steps
+//
+// osc_traffic_tool.py corpus turns recordings into inputs of this form.
+
+#include "host_stubs.h"
+#include "Config.h"
+#include "ExecutorStatus.h"
+#include "NetworkOSC.h"
+#include <stddef.h>
+#include <stdint.h>
+
+static constexpr size_t MAX_PACKETS_PER_INPUT = 32;
+static constexpr uint32_t TIME_STEP_MS = 50;
+static constexpr uint16_t CONSOLE_PORT = 9000;
+
+static const IPAddress SENDERS[4] = {
+  IPAddress(192, 168, 0, 10),    // netConfig.sendToIP default
+  IPAddress(192, 168, 0, 11),    // netConfig.backupIP default
+  IPAddress(192, 168, 0, 50),
+  IPAddress(10, 0, 0, 7),
+};
+
+static void setupOnce() {
+  static bool done = false;
+  if (done) return;
+  done = true;
+  netConfig.useBackup = true;   // Reach the failover code too
+}
+
+// Things no input may break, whatever it contains
+static void checkInvariants() {
+  if (currentOSCPage < 1 || currentOSCPage > 9999) __builtin_trap();
+  for (int i = 0; i < NUM_FADERS; i++) {
+    if (faders[i].setpoint > 100) __builtin_trap();
+  }
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+    if (executorStatus[i] > 2) __builtin_trap();
+  }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+  setupOnce();
+  hostResetFaders();
+  currentOSCPage = 1;
+
+  size_t pos = 0;
+  for (size_t n = 0; n < MAX_PACKETS_PER_INPUT && pos + 3 <= size; n++) {
+    const uint8_t flags = data[pos];
+    size_t len = ((size_t)data[pos + 1] << 8) | data[pos + 2];
+    pos += 3;
+    if (len > size - pos) {
+      len = size - pos;
+    }
+
+    hostAdvanceMillis((flags >> 2) * TIME_STEP_MS);
+    queueIncomingOsc(data + pos, len, SENDERS[flags & 3], CONSOLE_PORT);
+    processOscQueue();
+    pos += len;
+  }
+
+  // Colors wait for the control lane to be idle
+  processOscQueue();
+  checkInvariants();
+  return 0;
+}
@@ -0,0 +1,85 @@
+// regress_main.cpp
+//
+// Runs LLVMFuzzerTestOneInput once per file without libFuzzer, so the committed corpus and
+// regression inputs can be checked with any compiler (g++ with ASan/UBSan included).
+// An input that crashes fails through the sanitizers; one slower than the limit fails here.
+//
+//   osc_ingest_regress [--slow-us N] file_or_directory...
+
+#include <chrono>
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+static constexpr long DEFAULT_SLOW_US = 20000;   // Host time; the wing's budget is 8 ms per pass
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& out) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  uint8_t buf[4096];
+  size_t n;
+  out.clear();
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    out.insert(out.end(), buf, buf + n);
+  }
+  fclose(f);
+  return true;
+}
+
+static void collect(const std::string& path, std::vector<std::string>& files) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    fprintf(stderr, "%s: not found\n", path.c_str());
+    exit(2);
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    files.push_back(path);
+    return;
+  }
+  DIR* dir = opendir(path.c_str());
+  while (struct dirent* e = readdir(dir)) {
+    if (e->d_name[0] != '.') {
+      collect(path + "/" + e->d_name, files);
+    }
+  }
+  closedir(dir);
+}
+
+int main(int argc, char** argv) {
+  long slowUs = DEFAULT_SLOW_US;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--slow-us") == 0 && i + 1 < argc) {
+      slowUs = atol(argv[++i]);
+    } else {
+      collect(argv[i], files);
+    }
+  }
+
+  int slow = 0;
+  std::vector<uint8_t> data;
+  for (const std::string& path : files) {
+    if (!readFile(path, data)) {
+      fprintf(stderr, "%s: cannot read\n", path.c_str());
+      return 2;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+    const long us = (long)std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start).count();
+    if (us > slowUs) {
+      printf("SLOW %6ld us  %s\n", us, path.c_str());
+      slow++;
+    }
+  }
+
+  printf("%zu inputs, %d slow\n", files.size(), slow);
+  return slow ? 1 : 0;
+}
@@ -0,0 +1,221 @@
+// ColorMathCheck.cpp
+//
+// Host check for ColorMath.cpp: integer scaling against the old float path, gamma tables
+// and dithering. Built on a PC, outside PlatformIO (see the Makefile here).
+//
+//   make -C hostcheck check          all brightness values for every color (2^32 inputs, a few minutes)
+//   make -C hostcheck check-quick    every 17th brightness
+//
+// Exits non-zero if a check fails.
+
+#include "ColorMath.h"
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+  printf("%-60s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok) failures++;
+}
+
+//================================
+// REFERENCE: FLOAT HSV PATH
+//================================
+
+// getScaledColor() before the integer pipeline: RGB -> HSV, replace V, back to RGB
+static uint32_t floatScaledColor(uint8_t red, uint8_t green, uint8_t blue, uint8_t brightness) {
+  if (red == 0 && green == 0 && blue == 0) {
+    return 0;
+  }
+
+  float r = red / 255.0f;
+  float g = green / 255.0f;
+  float b = blue / 255.0f;
+
+  float cmax = std::max(r, std::max(g, b));
+  float cmin = std::min(r, std::min(g, b));
+  float delta = cmax - cmin;
+
+  float h = 0, s = 0;
+  if (delta != 0) {
+    if (cmax == r) h = fmodf(((g - b) / delta), 6.0f);
+    else if (cmax == g) h = ((b - r) / delta) + 2.0f;
+    else h = ((r - g) / delta) + 4.0f;
+
+    h *= 60.0f;
+    if (h < 0) h += 360.0f;
+  }
+  if (cmax != 0) s = delta / cmax;
+
+  float scaledV = brightness / 255.0f;
+  float c = scaledV * s;
+  float x = c * (1 - fabsf(fmodf(h / 60.0f, 2) - 1));
+  float m = scaledV - c;
+
+  float r1 = 0, g1 = 0, b1 = 0;
+  if (h < 60)      { r1 = c; g1 = x; }
+  else if (h < 120){ r1 = x; g1 = c; }
+  else if (h < 180){ g1 = c; b1 = x; }
+  else if (h < 240){ g1 = x; b1 = c; }
+  else if (h < 300){ r1 = x; b1 = c; }
+  else             { r1 = c; b1 = x; }
+
+  return ((uint32_t)(uint8_t)((r1 + m) * 255) << 16) |
+         ((uint32_t)(uint8_t)((g1 + m) * 255) << 8) |
+         (uint8_t)((b1 + m) * 255);
+}
+
+// Exact hue-preserving scale: channel * brightness / max, rounded down
+static uint32_t exactScaledColor(uint8_t r, uint8_t g, uint8_t b, uint8_t brightness) {
+  const uint32_t cmax = std::max(r, std::max(g, b));
+  if (cmax == 0) return 0;
+  return ((r * brightness / cmax) << 16) | ((g * brightness / cmax) << 8) | (b * brightness / cmax);
+}
+
+//================================
+// INTEGER SCALING
+//================================
+
+static void checkScale8() {
+  bool ok = true;
+  for (uint32_t v = 0; v < 256 && ok; v++) {
+    for (uint32_t s = 0; s < 256; s++) {
+      if (scale8(v, s) != v * s / 255) { ok = false; break; }
+    }
+  }
+  check(ok, "scale8 == value * scale / 255 for all 8-bit inputs");
+}
+
+static void checkAgainstFloat(int brightnessStep) {
+  uint64_t total = 0, identical = 0, oneLsb = 0, worse = 0, notExact = 0;
+  for (uint32_t rgb = 0; rgb < (1u << 24); rgb++) {
+    const uint8_t r = rgb >> 16, g = rgb >> 8, b = rgb;
+    for (int v = 0; v < 256; v += brightnessStep) {
+      const uint32_t fixed = scaleColorToBrightness(r, g, b, v);
+      const uint32_t ref = floatScaledColor(r, g, b, v);
+      total++;
+      if (fixed != exactScaledColor(r, g, b, v)) notExact++;
+      if (fixed == ref) {
+        identical++;
+        continue;
+      }
+      int maxDiff = 0;
+      for (int shift = 0; shift <= 16; shift += 8) {
+        maxDiff = std::max(maxDiff, abs((int)((fixed >> shift) & 0xFF) - (int)((ref >> shift) & 0xFF)));
+      }
+      if (maxDiff == 1) oneLsb++;
+      else worse++;
+    }
+  }
+
+  printf("%llu inputs: %.2f%% identical to the float path, %.2f%% 1 LSB apart, %llu further apart\n",
+         (unsigned long long)total, 100.0 * identical / total, 100.0 * oneLsb / total, (unsigned long long)worse);
+  check(notExact == 0, "scaleColorToBrightness == channel * brightness / max");
+  check(worse == 0, "never more than 1 LSB from the float HSV path");
+}
+
+static void benchmark() {
+  const int N = 1 << 24;
+  volatile uint32_t sink = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < N; i++) {
+    sink = sink + floatScaledColor(i >> 16, i >> 8, i, i * 7);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < N; i++) {
+    sink = sink + scaleColorToBrightness(i >> 16, i >> 8, i, i * 7);
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  const double floatNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+  const double fixedNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / N;
+  printf("float HSV %.1f ns, integer %.1f ns per call (host)\n", floatNs, fixedNs);
+}
+
+//================================
+// GAMMA AND DITHERING
+//================================
+
+static void checkScaleColor16() {
+  bool ok = true;
+  for (uint32_t c = 0; c < 256 && ok; c++) {
+    for (uint32_t s = 0; s < 256; s++) {
+      uint16_t out[3];
+      scaleColor16(c, c, c, s, out);
+      if (out[0] != ((c * s) << 8) / 255 || (out[0] >> 8) != scale8(c, s)) { ok = false; break; }
+    }
+  }
+  check(ok, "scaleColor16 == (c * s << 8) / 255, high byte == scale8");
+}
+
+static void checkGamma() {
+  initGammaTables();
+  int worst = 0;
+  bool monotonic = true;
+  uint16_t prev = 0;
+  for (uint32_t level = 0; level < 65536; level++) {
+    const uint16_t linear = linearFromPerceptual(level);
+    if (linear < prev) monotonic = false;
+    prev = linear;
+  }
+  for (int b = 0; b < 256; b++) {
+    const int back = linearFromPerceptual(perceptualLevel(b));
+    worst = std::max(worst, abs(back - b * 65535 / 255));
+  }
+  printf("gamma round trip: worst %d / 65535\n", worst);
+  check(monotonic, "linearFromPerceptual is monotonic");
+  check(worst <= 3, "8-bit -> perceptual -> linear round trip within 3 / 65535");
+}
+
+// Over 256 frames the dithered output must add up to the 16-bit value exactly, with no bias,
+// and shorter aligned windows should already be close
+static void checkDither() {
+  bool exact = true;
+  double worst16 = 0;
+  for (uint32_t value = 0; value < 255 * 256; value++) {
+    const uint16_t channels[3] = {(uint16_t)value, (uint16_t)value, (uint16_t)value};
+    uint32_t sum = 0, window = 0;
+    for (uint32_t phase = 0; phase < 256; phase++) {
+      const uint32_t out = ditherColor16(channels, phase) & 0xFF;
+      sum += out;
+      window += out;
+      if ((phase & 15) == 15) {
+        worst16 = std::max(worst16, fabs(window / 16.0 - value / 256.0));
+        window = 0;
+      }
+    }
+    if (sum != value) exact = false;
+  }
+  printf("dither: worst 16-frame average %.4f LSB from the 16-bit value\n", worst16);
+  check(exact, "256-frame dither average == 16-bit value (no bias)");
+  check(worst16 < 1.0, "every aligned 16-frame window within 1 LSB");
+
+  const uint16_t dimMixed[3] = {10 << 8, 5 << 8 | 0x02, 0};
+  const uint16_t dimWhite[3] = {10 << 8, 10 << 8, 10 << 8};
+  const uint16_t brightMixed[3] = {200 << 8, 100 << 8 | 0x80, 0};
+  check(needsDither(dimMixed) && !needsDither(dimWhite) && !needsDither(brightMixed),
+        "needsDither only for dim colors with a fraction");
+}
+
+//================================
+// MAIN
+//================================
+
+int main(int argc, char** argv) {
+  const bool quick = (argc > 1 && strcmp(argv[1], "quick") == 0);
+
+  checkScale8();
+  checkAgainstFloat(quick ? 17 : 1);
+  checkScaleColor16();
+  checkGamma();
+  checkDither();
+  benchmark();
+
+  printf("%s\n", failures ? "FAILED" : "all checks passed");
+  return failures ? 1 : 0;
+}
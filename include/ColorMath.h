@@ -0,0 +1,55 @@
+// ColorMath.h
+#ifndef COLOR_MATH_H
+#define COLOR_MATH_H
+
+#include <stdint.h>
+
+//================================
+// INTEGER COLOR SCALING
+//================================
+
+// Shared by the fader and key strips. Integer only, no float or division in the
+// per-frame path. Colors are packed 0xRRGGBB like LedStrip::Color().
+// No Arduino dependencies, so hostcheck/ColorMathCheck.cpp can verify it on the host.
+
+// value * scale / 255, rounded down (exact for all 8-bit inputs)
+static inline uint8_t scale8(uint8_t value, uint8_t scale) {
+  const uint32_t x = (uint32_t)value * scale;
+  return (uint8_t)((x + 1 + (x >> 8)) >> 8);
+}
+
+// Keeps hue and saturation and sets the brightest channel to brightness: same result as
+// converting to HSV, replacing V and converting back, without the float round trip
+uint32_t scaleColorToBrightness(uint8_t r, uint8_t g, uint8_t b, uint8_t brightness);
+
+// Same with 16-bit brightness (0-65535) and 16-bit channels out, for dithering
+void scaleColorToBrightness16(uint8_t r, uint8_t g, uint8_t b, uint16_t brightness, uint16_t out[3]);
+
+// Each channel * scale / 255 in 8.8 fixed point: the high byte is scale8(), the low byte
+// the fraction it drops, for dithering
+void scaleColor16(uint8_t r, uint8_t g, uint8_t b, uint8_t scale, uint16_t out[3]);
+
+//================================
+// GAMMA AND DITHERING
+//================================
+
+// Fades run in a perceptual level (0-65535, gamma LED_GAMMA) so they look even; the
+// configured 8-bit brightness values stay linear, so the end points look as before.
+
+#define LED_GAMMA 2.2f
+#define LED_DITHER_BELOW_LEVEL 64   // 8-bit level; above it one step is too small to see
+
+void initGammaTables();                              // Once at startup, before the first fade
+uint16_t perceptualLevel(uint8_t brightness);        // Linear 8-bit brightness -> perceptual level
+uint16_t linearFromPerceptual(uint16_t level);       // Perceptual level -> linear 16-bit brightness
+
+// True if every channel is below LED_DITHER_BELOW_LEVEL and some channel has a fraction
+// that plain rounding would lose
+bool needsDither(const uint16_t channels[3]);
+
+// Rounds 16-bit channels to 8 bits with an ordered 8-bit threshold: over 256 frames each
+// pixel averages the full 16-bit value exactly. phase should change every frame and differ
+// between pixels.
+uint32_t ditherColor16(const uint16_t channels[3], uint8_t phase);
+
+#endif // COLOR_MATH_H
@@ -43,20 +43,34 @@
 // OSC settings
 #define OSC_VALUE_THRESHOLD 2    // Minimum value change to send OSC update
 #define OSC_RATE_LIMIT     20    // Minimum ms between OSC messages
+#define OSC_TRANSPORT_UDP  0     // netConfig.oscTransport: AsyncUDP datagrams
+#define OSC_TRANSPORT_TCP  1     // netConfig.oscTransport: SLIP framed stream to the console (UDP still listens)
 
 // NeoPixel configuration
 #define NEOPIXEL_PIN 12
 #define PIXELS_PER_FADER 24
 #define NUM_PIXELS (NUM_FADERS * PIXELS_PER_FADER)
 
-// Executor key NeoPixel strip (40 keys, 2 pixels each)
+// Executor key NeoPixel strip (40 keys, 2 pixels each with the default key map)
 #define NUM_EXECUTORS_TRACKED 40
 #define EXECUTOR_PIXELS_PER_KEY 2
+#define KEY_LED_MAX_PIXELS 8          // Pixels one key can have in the key LED map
 #define EXECUTOR_LED_PIN 53   // Teensy 4.1 pin for the key strip
 #define EXECUTOR_LED_COUNT (NUM_EXECUTORS_TRACKED * EXECUTOR_PIXELS_PER_KEY)
 #define EXECUTOR_BASE_BRIGHTNESS 10   // Default base brightness for populated-but-off keys
 #define EXECUTOR_ACTIVE_BRIGHTNESS 80 // Default brightness for active/on keys (unpopulated stays dark)
 
+// Both strips are sent in parallel (LedOutput.h): frame time follows the pixels per pin,
+// so either strip can grow up to this length without slowing the frame down
+#define LED_STRIP_LENGTH 240
+#define LED_FRAME_RATE 100    // LED frames per second; a 240 pixel frame takes ~7.5ms to send
+
+// sACN (E1.31) LED input defaults, see SacnReceiver.h
+#define SACN_DEFAULT_UNIVERSE 1
+#define SACN_DEFAULT_FADER_ADDRESS 1    // 10 faders x RGB
+#define SACN_DEFAULT_KEY_ADDRESS 31     // 40 keys x RGB
+#define SACN_DEFAULT_WING_PRIORITY 50   // Below a default sender (100), so sACN takes over
+
 // Touch sensor configuration
 #if defined(TOUCH_SENSOR_MTCH2120) && defined(TOUCH_SENSOR_MPR121)
 #error "Select only one touch sensor: TOUCH_SENSOR_MTCH2120 or TOUCH_SENSOR_MPR121"
@@ -115,6 +129,11 @@ struct NetworkConfig {
   uint16_t  receivePort;  // OSC listening port (e.g. 8000)
   uint16_t  sendPort;     // OSC destination port (e.g. 9000)
   bool      useDHCP;      // If true, use DHCP instead of static IP
+  IPAddress multicastIP;  // OSC multicast group (239.x.x.x), shared by several wings
+  bool      useMulticast; // If true, also receive OSC sent to multicastIP
+  IPAddress backupIP;     // Backup console, also receives all OSC output
+  bool      useBackup;    // If true, send to backupIP and fail over to it when sendToIP goes quiet
+  uint8_t   oscTransport; // OSC_TRANSPORT_UDP or OSC_TRANSPORT_TCP
 };
 
 //================================
@@ -136,6 +155,7 @@ struct FaderConfig {
   bool serialDebug;
   bool sendKeystrokes;       // Send keystroke using usb rather than osc for exec keys, this gives more native support (can store using exec key directly)
   bool useLevelPixels;       // When true, render per-fader level bars instead of full fill
+  bool ditherDimColors;      // Keep dithering settled dim colors (those LEDs are redrawn every frame)
 };
 
 // Executor LED configuration
@@ -149,6 +169,27 @@ struct ExecConfig {
   uint8_t reserved[2];        // Space for future options
 };
 
+// Executor key LED map: where each key's pixels sit on the key strip (EEPROM, web editable)
+struct KeyLedMapEntry {
+  uint16_t start;             // First pixel on the key strip
+  uint8_t count;              // Consecutive pixels for this key, 0 = no LEDs
+  uint8_t reserved;
+};
+
+struct KeyLedMap {
+  KeyLedMapEntry keys[NUM_EXECUTORS_TRACKED];   // Same order as EXECUTOR_IDS
+};
+
+// sACN (E1.31) LED input
+struct SacnConfig {
+  bool enabled;
+  uint8_t wingPriority;       // sACN priority given to the wing's own colors (0-200)
+  uint16_t universe;          // 1-63999
+  uint16_t faderAddress;      // First DMX channel of the fader block, 0 = faders not driven
+  uint16_t keyAddress;        // First DMX channel of the key block, 0 = keys not driven
+  uint8_t reserved[2];
+};
+
 // Touch sensor configuration
 struct TouchConfig {
   uint8_t autoCalibrationMode;  // 0=AutoTune off, 1=AutoTune on
@@ -178,6 +219,9 @@ struct Fader {
   uint8_t lastSentOscValue;     // Last value sent via OSC
 
   unsigned long lastOscSendTime; // Time of last OSC message
+  int echoPage;                  // Page the last value was sent on
+  uint32_t echoConfirmSeq;       // Console link ping that proves the console has applied our last value
+  int16_t heldEchoValue;         // Last console value ignored as stale, -1 if none
 
   uint16_t oscID;           // OSC ID like 201 for /Page2/Fader201
   int lastAnalogValue;      // Last raw analog reading to suppress small jitter
@@ -192,8 +236,14 @@ struct Fader {
   uint8_t currentBrightness;           // Actual brightness applied this frame
   uint8_t targetBrightness;            // Target brightness based on touch
   unsigned long brightnessStartTime;   // When fade began
+  unsigned long fadeDuration;          // Fconfig.fadeTime when the fade began
+  int32_t fadeRate;                    // Perceptual levels per ms, 20.12 fixed point
+  uint16_t fadeStartLevel;             // Perceptual level (ColorMath.h) the fade started from
+  uint16_t fadeLevel;                  // Perceptual level the fade has reached
   uint8_t lastReportedBrightness;      // For debug: last brightness sent
   uint32_t lastRenderedColor;          // Last color pushed to strip (scaled)
+  uint32_t scaledColorKey;             // red/green/blue/currentBrightness scaledColor was computed for
+  uint32_t scaledColor;                // Memoized getScaledColor() result
   uint8_t lastRenderedSetpoint;        // Last setpoint used when rendering level pixels
   
   // Touch Values
@@ -214,6 +264,9 @@ extern Fader faders[NUM_FADERS];
 extern NetworkConfig netConfig;
 extern FaderConfig Fconfig;
 extern ExecConfig execConfig;
+extern KeyLedMap keyLedMap;
+extern SacnConfig sacnConfig;
+extern const KeyLedMap DEFAULT_KEY_LED_MAP;
 
 // Page tracking
 extern int currentOSCPage;
@@ -0,0 +1,92 @@
+// ConsoleLink.h
+#ifndef CONSOLE_LINK_H
+#define CONSOLE_LINK_H
+
+#include <Arduino.h>
+
+//================================
+// CONSOLE LINK HEALTH
+//================================
+
+// Link health comes from the plugin's 1s heartbeat, so no command is needed to keep it.
+// The wing pings by setting the EvoPing global variable through /cmd ("seq,millis,wingId")
+// only after a fader release or key press, and every 30s for a fresh round trip. The Lua
+// plugin answers every new value with /pong,iii,seq,millis,wingId so round trips are
+// measured on the wing's own clock.
+// Every wing on the console writes the same variable and receives every pong, so
+// the wing id (low 24 bits of the MAC) keeps them from taking each other's pongs.
+// Consoles running an older plugin send neither; the link then stays UNKNOWN
+// and nothing is held back.
+//
+// Resync: the wing sets forceReload through the same /cmd path at boot, on link up,
+// after a failover and when a heartbeat shows an update it never received. The
+// plugin answers with a full snapshot on its next tick.
+//
+// Pings share the path of fader writes and the plugin answers them before it reads
+// executor state, so once the pong for a ping sent after a write arrives, every
+// later bundle already reflects that write. Fader echo suppression relies on this.
+
+enum ConsoleLinkState : uint8_t {
+  LINK_UNKNOWN = 0,   // No heartbeat or pong since boot
+  LINK_GOOD,
+  LINK_DEGRADED,      // Heartbeats late or missing, or round trip slow/jittery
+  LINK_LOST,          // Nothing heard for a while: motors hold, resync requested on return
+  LINK_STATE_COUNT
+};
+
+// Why the wing asked the plugin for a full snapshot
+enum ConsoleResyncReason : uint8_t {
+  RESYNC_BOOT = 0,     // First network link after power-up
+  RESYNC_LINK_UP,      // Ethernet link or console link came back
+  RESYNC_SEQ_GAP,      // Heartbeat says we missed the plugin's last update
+  RESYNC_FAILOVER,     // Switched to the other console
+  RESYNC_FADER_ECHO,   // A console fader value was held back while our write was unconfirmed
+  RESYNC_REASON_COUNT
+};
+
+// Update streams the plugin numbers (trailing int on each bundle, echoed in /heartbeat)
+enum ConsoleUpdateStream : uint8_t {
+  CONSOLE_STREAM_EXEC = 0,
+  CONSOLE_STREAM_COLOR,
+  CONSOLE_STREAM_COUNT
+};
+
+struct ConsoleLinkStats {
+  uint8_t  state;             // ConsoleLinkState
+  uint32_t pingsSent;
+  uint32_t pongsReceived;
+  uint32_t latePongs;         // Duplicate or older than the newest pong already seen
+  uint32_t otherWingPongs;    // Answers to another wing's ping
+  uint32_t lastSeq;           // Sequence number of the last ping sent
+  uint32_t lastPongSeq;
+  uint32_t lastRttMs;
+  uint32_t srttMs;            // Smoothed round trip (1/8 EWMA)
+  uint32_t jitterMs;          // Smoothed deviation (1/4 EWMA)
+  uint32_t lastPongAgeMs;     // Since the last pong, 0 until one arrives
+  uint32_t lostCount;         // Times the link went LOST
+  uint32_t resyncRequests;
+  uint32_t resyncByReason[RESYNC_REASON_COUNT];
+  uint32_t seqGaps;           // Bundles that skipped sequence numbers (each bundle is a full snapshot)
+  uint32_t missedUpdates;     // Heartbeats showing an update that never arrived
+};
+
+//================================
+// FUNCTION DECLARATIONS
+//================================
+
+void consoleLinkLoop();                            // Send due pings and update the state (call from loop)
+void handleConsolePong(int32_t seq, int32_t sentMs, int32_t wingId);
+bool consoleLinkAllowsMotion();                    // false while LOST
+void requestConsoleResync(uint8_t reason);         // Ask the plugin to resend everything (rate limited)
+void noteConsoleUpdateSeq(uint8_t stream, int32_t seq);
+void handleConsoleHeartbeat(int32_t execSeq, int32_t colorSeq);
+void displayConsoleLinkStatus();                   // Redraw the OLED status line
+void consoleLinkPingSoon();                        // Ping on the next loop (rate limited)
+uint32_t consoleLinkNextPingSeq();                 // Sequence of the next ping, sent after anything queued now
+bool consoleLinkConfirms(uint32_t seq);            // Pong for seq (or later) received
+bool consoleLinkHasPongs();                        // Plugin answers pings, so confirmations can be waited for
+const ConsoleLinkStats& getConsoleLinkStats();
+const char* consoleLinkStateName(uint8_t state);
+const char* consoleResyncReasonName(uint8_t reason);
+
+#endif // CONSOLE_LINK_H
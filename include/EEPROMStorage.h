@@ -16,8 +16,13 @@
 #define CALCFG_EEPROM_SIGNATURE 0xA4    // Signature for fader calibration
 #define FADERCFG_EEPROM_SIGNATURE 0xB7    // Signature for fader configuration
 #define NETCFG_EEPROM_SIGNATURE 0x5B    // Signature for network config
+#define NETCFG_MCAST_SIGNATURE 0x6C     // Signature for the multicast fields appended to the network config
+#define NETCFG_BACKUP_SIGNATURE 0x7D    // Signature for the backup console fields appended after multicast
+#define NETCFG_TRANSPORT_SIGNATURE 0x8E // Signature for the OSC transport field appended after backup
 #define TOUCHCFG_EEPROM_SIGNATURE 0xC6     // Signature for touch sensor configuration
 #define EXECCFG_EEPROM_SIGNATURE 0xD6     // Signature for executor LED configuration
+#define KEYMAP_EEPROM_SIGNATURE 0xE5      // Signature for the executor key LED map
+#define SACN_EEPROM_SIGNATURE 0xF3        // Signature for sACN input settings
 
 // EEPROM address map with defined layout to ensure organized storage
 #define EEPROM_CAL_START 0              // Start of calibration section (original location)
@@ -25,7 +30,9 @@
 #define EEPROM_CONFIG_START 200         // Start of fader config section
 #define EEPROM_TOUCH_START 400          // Start of touch config
 #define EEPROM_EXEC_START 520           // Executor LED config
-#define EEPROM_RESERVED_START 640       // Reserved for future expansion
+#define EEPROM_KEYMAP_START 640         // Executor key LED map (1 + 160 bytes)
+#define EEPROM_SACN_START 820           // sACN input settings
+#define EEPROM_RESERVED_START 840       // Reserved for future expansion
 
 // EEPROM layout for calibration data
 #define EEPROM_CAL_SIGNATURE_ADDR EEPROM_CAL_START
@@ -43,6 +50,14 @@
 #define EEPROM_EXEC_SIGNATURE_ADDR EEPROM_EXEC_START
 #define EEPROM_EXEC_DATA_ADDR (EEPROM_EXEC_SIGNATURE_ADDR + 1)
 
+// EEPROM layout for the executor key LED map
+#define EEPROM_KEYMAP_SIGNATURE_ADDR EEPROM_KEYMAP_START
+#define EEPROM_KEYMAP_DATA_ADDR (EEPROM_KEYMAP_SIGNATURE_ADDR + 1)
+
+// EEPROM layout for sACN input settings
+#define EEPROM_SACN_SIGNATURE_ADDR EEPROM_SACN_START
+#define EEPROM_SACN_DATA_ADDR (EEPROM_SACN_SIGNATURE_ADDR + 1)
+
 //================================
 // FUNCTION DECLARATIONS
 //================================
@@ -67,6 +82,10 @@ void loadTouchConfig();
 // Executor LED configuration functions
 void saveExecConfig();
 bool loadExecConfig();
+void saveKeyLedMap();
+bool loadKeyLedMap();
+void saveSacnConfig();
+bool loadSacnConfig();
 
 // Combined configuration functions
 void loadAllConfig();
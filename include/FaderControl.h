@@ -23,6 +23,10 @@ void moveAllFadersToSetpoints();
 int readFadertoOSC(Fader& f);
 int getFaderIndexFromID(int id);
 
+// Echo suppression
+bool isStaleFaderEcho(Fader& f, int page, int consoleValue);  // Console value older than our last write
+uint32_t getFaderEchoesIgnored();
+
 // Fader retry
 void checkFaderRetry();
 
@@ -9,7 +9,28 @@
 void setupKeyLeds();
 void updateKeyLeds();
 
-// Call when executor states change so the LEDs can refresh on the next loop
+// Mark keys for a redraw on the next LED frame: one key after its status or color
+// changed, all keys after a settings change
+void markKeyLedDirty(int execIndex);
 void markKeyLedsDirty();
 
+bool keyLedsDithering();   // Some dim key color is being dithered (redrawn every frame)
+
+// Rebuild the pixel table after keyLedMap changed (clears the strip and redraws every key)
+void applyKeyLedMap();
+bool isValidKeyLedMapEntry(const KeyLedMapEntry& entry);
+
+// Optimistic feedback: pressing a key that is off shows it on right away (keys that are
+// on wait for the console). Not used in keystroke mode. executorStatus stays authoritative;
+// the prediction is dropped once it matches, or reverted once the console has seen the
+// press and still disagrees.
+struct KeyLedPredictionStats {
+  uint32_t predicted;
+  uint32_t confirmed;   // Console status matched the prediction
+  uint32_t reverted;    // Console disagreed (lost presses, keys that do not latch on)
+};
+
+void predictKeyPress(int execIndex);
+const KeyLedPredictionStats& getKeyLedPredictionStats();
+
 #endif // KEY_LED_CONTROL_H
@@ -0,0 +1,40 @@
+// LedAnimation.h
+#ifndef LED_ANIMATION_H
+#define LED_ANIMATION_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+//================================
+// LED ANIMATION TIMELINE
+//================================
+
+// Effects that paint over whole fader segments for a while, one step per LED frame
+// (renderLedFrame), while OSC, touch and motors keep running. Normal rendering
+// carries on underneath and shows again as soon as an effect lets go of a fader.
+//
+// An effect's clock starts on the first frame it is stepped, so an effect started
+// just before a blocking section still plays in full afterwards. Up to
+// LED_ANIMATION_SLOTS effects run at once; on a fader the newest one wins.
+
+#define LED_ANIMATION_SLOTS 4
+#define ALL_FADERS_MASK ((uint16_t)((1U << NUM_FADERS) - 1))
+
+enum LedAnimationType : uint8_t {
+  LED_ANIM_NONE = 0,
+  LED_ANIM_STARTUP_WAVE,   // Staggered rainbow sweep that settles into each fader's color
+  LED_ANIM_FLASH           // Blink a color, normal rendering in between
+};
+
+//================================
+// FUNCTION DECLARATIONS
+//================================
+
+void startStartupWave(uint16_t staggerMs, uint16_t cycleMs);
+void startFaderFlash(uint16_t faderMask, uint32_t color, uint8_t count, uint16_t onMs, uint16_t offMs);
+
+void stepLedAnimations(uint32_t now);                    // Once per frame, before rendering
+bool getFaderAnimationColor(int faderIndex, uint32_t& color);   // Effect color for this frame, if any
+bool ledAnimationsActive();
+
+#endif // LED_ANIMATION_H
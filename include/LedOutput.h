@@ -0,0 +1,100 @@
+// LedOutput.h
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <Arduino.h>
+#include <OctoWS2811.h>
+#include "Config.h"
+
+//================================
+// PARALLEL DMA LED OUTPUT
+//================================
+
+// The fader strip and the executor-key strip go out together through OctoWS2811:
+// one frame buffer, one DMA transfer that clocks every pin at once. Frame time is
+// set by LED_STRIP_LENGTH (pixels per pin), not by the total pixel count, and
+// interrupts (UDP receive, touch IRQ) keep running while it goes out.
+//
+// Output n owns pixels n * LED_STRIP_LENGTH ... (n + 1) * LED_STRIP_LENGTH - 1.
+// Each strip is a LedStrip view onto its output with the Adafruit_NeoPixel calls
+// the drawing code already used.
+//
+// The main loop renders LEDs only when beginFrame() says a frame is due (LED_FRAME_RATE)
+// and closes with endFrame(): show() on a strip in between only marks the frame dirty
+// and endFrame() sends both strips at once, or keeps the frame for the next slot if
+// the previous one is still going out.
+// Outside a frame (setup, calibration, blocking effects) show() sends right away,
+// waiting for a frame still in flight first.
+
+enum LedOutputIndex : uint8_t {
+  LED_OUTPUT_FADERS = 0,   // NEOPIXEL_PIN
+  LED_OUTPUT_KEYS,         // EXECUTOR_LED_PIN
+  LED_OUTPUT_COUNT
+};
+
+class LedEngine {
+public:
+  LedEngine(const uint8_t* pins, uint8_t numOutputs, uint16_t pixelsPerOutput, int* frameBuf, int* drawBuf);
+
+  void begin();                              // Safe to call from every strip's setup
+  void setPixel(uint8_t output, uint16_t n, uint32_t color);
+  uint32_t getPixel(uint8_t output, uint16_t n);
+  uint16_t pixelsPerOutput() const { return perOutput; }
+
+  bool beginFrame();                         // false until the next frame slot
+  void endFrame();                           // Send the frame if any strip changed
+  void show();                               // From a strip: batched inside a frame, else sent now
+  bool busy();
+
+  uint32_t framesShown() const { return shown; }
+  uint32_t framesDeferred() const { return deferred; }   // Frames held a slot because DMA was busy
+  uint32_t framesRendered() const { return rendered; }   // Frame slots run, sent or not
+  uint32_t lastRenderUs() const { return renderUs; }     // beginFrame() to endFrame()
+  uint32_t maxRenderUs() const { return renderMaxUs; }
+  uint32_t transferUs() const { return (uint32_t)perOutput * 30 + 300; }   // 24 bits at 800kHz per pixel, plus latch
+
+private:
+  void transmit();
+
+  uint16_t perOutput;
+  uint8_t outputs;
+  OctoWS2811 leds;
+  bool started = false;
+  bool batching = false;
+  bool dirty = false;
+  uint32_t shown = 0;
+  uint32_t deferred = 0;
+  uint32_t rendered = 0;
+  uint32_t nextFrameUs = 0;
+  uint32_t frameStartUs = 0;
+  uint32_t renderUs = 0;
+  uint32_t renderMaxUs = 0;
+};
+
+class LedStrip {
+public:
+  LedStrip(LedEngine& engine, uint8_t output, uint16_t numPixels);
+
+  void begin();
+  void clear();
+  void setPixelColor(uint16_t n, uint32_t color);
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+  uint32_t getPixelColor(uint16_t n);
+  uint16_t numPixels() const { return count; }
+
+  void show();
+  bool canShow();        // Strip idle, a frame sent now would start at once
+
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+
+private:
+  LedEngine& engine;
+  uint8_t output;
+  uint16_t count;
+};
+
+extern LedEngine ledEngine;
+
+#endif // LED_OUTPUT_H
@@ -0,0 +1,47 @@
+// LwipStats.h
+#ifndef LWIP_STATS_VIEW_H
+#define LWIP_STATS_VIEW_H
+
+#include <Arduino.h>
+
+//================================
+// NETWORK STACK STATISTICS
+//================================
+
+// Read-only view of lwIP's counters (LWIP_STATS in include/lwipopts.h) for the web
+// statistics page. Everything reads zero if the stack is built without stats.
+
+struct LwipPoolStats {
+  const char* name;     // lwIP pool description, e.g. "PBUF_POOL"
+  uint32_t used;
+  uint32_t max;         // High-water mark since boot
+  uint32_t avail;       // Pool size
+  uint32_t err;         // Allocations that failed because the pool was empty
+};
+
+struct LwipStackStats {
+  uint32_t heapUsed;        // lwIP's fixed heap (MEM_SIZE): TCP/UDP transmit data
+  uint32_t heapMax;
+  uint32_t heapAvail;
+  uint32_t heapErr;
+  uint32_t linkDrops;       // Frames the driver dropped
+  uint32_t udpRecv;
+  uint32_t udpXmit;
+  uint32_t udpDrops;        // No matching socket, bad checksum or no memory
+  uint32_t udpMemErrors;
+  uint32_t tcpRecv;
+  uint32_t tcpXmit;
+  uint32_t tcpDrops;
+  uint32_t tcpRetransmits;
+  uint32_t tcpMemErrors;
+};
+
+//================================
+// FUNCTION DECLARATIONS
+//================================
+
+uint8_t getLwipPoolCount();
+bool getLwipPoolStats(uint8_t index, LwipPoolStats& out);
+void getLwipStackStats(LwipStackStats& out);
+
+#endif // LWIP_STATS_VIEW_H
@@ -3,14 +3,14 @@
 #define NEOPIXEL_CONTROL_H
 
 #include <Arduino.h>
-#include <Adafruit_NeoPixel.h>
+#include "LedOutput.h"
 #include "Config.h"
 
 //================================
 // GLOBAL NEOPIXEL OBJECT
 //================================
 
-extern Adafruit_NeoPixel pixels;
+extern LedStrip pixels;
 
 //================================
 // FUNCTION DECLARATIONS
@@ -18,14 +18,18 @@ extern Adafruit_NeoPixel pixels;
 
 // Setup and main update
 void setupNeoPixels();
+void renderLedFrame();                // From loop(): renders and sends a frame at LED_FRAME_RATE
 void updateNeoPixels();
 void updateBaseBrightnessPixels();
+void markFaderLedsDirty();
+uint32_t getDitheredFrameCount();     // LED frames with at least one dithered fader or key
 
 void updateBrightnessOnFaderTouchChange();
 
+// Non-blocking: start the effect, it plays from the next LED frames
 void fadeSequence(unsigned long STAGGER_DELAY, unsigned long COLOR_CYCLE_TIME);
 void flashAllFadersRed();
 
-uint32_t getScaledColor(const Fader& fader);
+uint32_t getScaledColor(Fader& fader);
 
 #endif // NEOPIXEL_CONTROL_H
\ No newline at end of file
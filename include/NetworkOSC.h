@@ -18,23 +18,108 @@ class AsyncUDP;
 
 extern AsyncUDP oscUdp;
 
+//================================
+// OSC PROCESSING STATISTICS
+//================================
+
+// Why processOscQueue() picked its budget on a given loop
+enum OscBudgetReason : uint8_t {
+  OSC_BUDGET_IDLE = 0,       // Nothing queued, defaults
+  OSC_BUDGET_STEADY,         // Light traffic, defaults
+  OSC_BUDGET_BACKLOG,        // Queue half full, drain faster
+  OSC_BUDGET_DROPS,          // Packets dropped recently, drain as fast as the loop target allows
+  OSC_BUDGET_LOOP_PRESSURE,  // Other loop stages are slow, budget reduced to protect motors/touch
+  OSC_BUDGET_REASON_COUNT
+};
+
+struct OscBudgetStats {
+  uint32_t budgetUs;                              // Time budget used on the last pass
+  uint8_t  packetLimit;                           // Packet cap used on the last pass
+  uint8_t  lastReason;                            // OscBudgetReason of the last pass
+  uint32_t loopOtherUs;                           // Smoothed time spent in the rest of loop() between passes
+  uint32_t oscStageUs;                            // Duration of the last OSC pass
+  uint32_t decisions[OSC_BUDGET_REASON_COUNT];    // How many passes each rule decided
+};
+
+// Inbound message types counted by the receive telemetry
+enum OscMsgType : uint8_t {
+  OSC_MSG_EXEC = 0,          // /execUpdate bundles
+  OSC_MSG_COLOR,             // /colorUpdate bundles
+  OSC_MSG_PAGE,              // /updatePage/current
+  OSC_MSG_STATS,             // /stats requests
+  OSC_MSG_OTHER,             // Parsed but not for us (and /heartbeat, /pong, which feed the console timeout and link health)
+  OSC_MSG_TYPE_COUNT
+};
+
+#define OSC_LATENCY_BUCKETS 8
+
+struct OscRxStats {
+  uint32_t received;                              // Packets seen by the UDP callback (all counters are since boot)
+  uint32_t handled[OSC_MSG_TYPE_COUNT];           // Packets handled, per message type
+  uint32_t queueDrops;                            // Control lane full
+  uint32_t oversizeDrops;                         // Larger than the queue slot
+  uint32_t colorCoalesced;                        // Color bundles replaced before being handled
+  uint32_t colorStale;                            // Color bundles for another page, dropped
+  uint32_t parseFailures;                         // Not valid OSC
+  uint32_t malformed;                             // Valid OSC but wrong argument count/types
+  uint8_t  queueHighWater;                        // Deepest the control lane has been
+  uint32_t latencyLastUs;                         // Enqueue to handled, last packet
+  uint32_t latencyMaxUs;                          // Enqueue to handled, worst packet
+  uint32_t latencyHist[OSC_LATENCY_BUCKETS];      // See oscLatencyBucketLimitUs()
+};
+
+// Consoles the wing talks to: output goes to all enabled ones, input is applied from the active one
+enum OscDestinationSlot : uint8_t {
+  OSC_DEST_PRIMARY = 0,
+  OSC_DEST_BACKUP,
+  OSC_MAX_DESTINATIONS
+};
+
+struct OscDestination {
+  IPAddress ip;
+  bool     enabled;
+  bool     heard;           // Any packet received from this console yet
+  uint32_t sent;            // Packets written to this console
+  uint32_t sendErrors;      // writeTo() failures
+  uint32_t received;        // Packets received from this console
+  uint32_t ignored;         // Received while the other console was the sync source
+  uint32_t lastHeardMs;     // millis() of the last packet from this console
+};
+
 //================================
 // FUNCTION DECLARATIONS
 //================================
 
 // Network setup and management
-void setupNetwork();
+void setupNetwork();     // Starts link/DHCP without waiting for an address
+void networkLoop();      // DHCP timeout fallback, address changes (call from loop)
+bool networkReady();     // Link up and an address assigned
+const char* networkStateName();
 void restartUDP();
+void updateMulticastMembership();  // Join/leave the OSC multicast group to match netConfig
+bool isMulticastAddress(const IPAddress& ip);
 void processOscQueue();  // Process queued OSC packets (call from loop)
+bool queueIncomingOsc(const uint8_t* data, size_t len, const IPAddress& srcIP, uint16_t srcPort);
+const OscBudgetStats& getOscBudgetStats();
+const char* oscBudgetReasonName(uint8_t reason);
+void getOscRxStats(OscRxStats& out);
+uint32_t oscLatencyBucketLimitUs(uint8_t bucket);  // Upper bound in us, 0 for the open last bucket
+const char* oscMsgTypeName(uint8_t type);
+const OscDestination& getOscDestination(uint8_t index);
+uint8_t getOscActiveSource();     // OscDestinationSlot currently applied as sync source
+uint32_t getOscFailoverCount();
+bool isValidDestination(const IPAddress& ip);
 
 
 
 // OSC message handling
 void sendFaderOsc(Fader& f, int value, bool force = false);
 void sendOscMessage(const char* address, const char* typeTag, const void* value);
+void sendOscInts(const char* address, const int32_t* values, uint8_t count, const IPAddress& ip, uint16_t port);
 
 // Page update
 void handlePageUpdate(const char *address, int value);
+void invalidateColorCache();  // Force the next color bundle to re-apply every executor
 
 
 // OSC utility functions
@@ -0,0 +1,44 @@
+// OscTcp.h
+#ifndef OSC_TCP_H
+#define OSC_TCP_H
+
+#include <Arduino.h>
+#include <QNEthernet.h>
+
+using namespace qindesign::network;
+
+//================================
+// OSC OVER TCP (SLIP FRAMED)
+//================================
+
+// OSC 1.1 stream transport: every message is SLIP encoded with an END byte on both
+// sides. The wing connects to the active console on the OSC send port; messages
+// received on that connection go into the same queue as UDP packets. Output for the
+// active console is queued even while the connection is down and sent in order once
+// it is back; when the queue is full the oldest messages make room.
+
+struct OscTcpStats {
+  bool      connected;
+  IPAddress remoteIP;
+  uint32_t  connects;          // Successful connections
+  uint32_t  connectFailures;   // Attempts that timed out or were refused
+  uint32_t  disconnects;       // Established connections that dropped
+  uint32_t  framesSent;        // OSC messages queued onto the stream
+  uint32_t  batchesSent;       // Writes to the stream (one per loop with pending data)
+  uint32_t  bytesSent;
+  uint32_t  framesReceived;
+  uint32_t  txOverflows;       // Messages dropped for lack of room (the oldest whole ones first)
+  uint32_t  rxOverflows;       // Incoming frames longer than an OSC packet
+  uint32_t  backoffMs;         // Wait before the next connect attempt
+};
+
+//================================
+// FUNCTION DECLARATIONS
+//================================
+
+void oscTcpLoop();    // Connect/reconnect, read frames and flush the batch (call from loop)
+void oscTcpReset();   // Drop the connection after settings change
+bool oscTcpQueueMessage(const uint8_t* data, size_t len, const IPAddress& ip);  // false if ip is not the stream's console (use UDP)
+const OscTcpStats& getOscTcpStats();
+
+#endif // OSC_TCP_H
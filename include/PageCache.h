@@ -0,0 +1,35 @@
+// PageCache.h
+#ifndef PAGE_CACHE_H
+#define PAGE_CACHE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+//================================
+// PER-PAGE STATE CACHE
+//================================
+
+// Last known fader setpoints, executor statuses and colors for the most recently
+// used pages. A page change (/updatePage/current) is applied from here straight
+// away; the console's next bundles for that page are authoritative and overwrite it.
+
+#define PAGE_CACHE_SLOTS 4
+
+struct PageCacheStats {
+  uint32_t hits;          // Page changes applied from the cache
+  uint32_t misses;        // Page changes with nothing cached, wait for the console
+  uint32_t corrections;   // Console bundle after a hit differed from the cached values
+  uint32_t evictions;     // Oldest page dropped to make room
+  uint8_t  entries;       // Slots in use
+};
+
+//================================
+// FUNCTION DECLARATIONS
+//================================
+
+void pageCacheStoreExec(int page, const uint8_t* setpoints);  // After a clean exec bundle (10 fader values, statuses from executorStatus)
+void pageCacheStoreColors(int page);                          // After a clean color bundle (from executorColors)
+bool pageCacheApply(int page);                                // Page change: drive faders and LEDs from the cache
+const PageCacheStats& getPageCacheStats();
+
+#endif // PAGE_CACHE_H
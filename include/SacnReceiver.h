@@ -0,0 +1,57 @@
+// SacnReceiver.h
+#ifndef SACN_RECEIVER_H
+#define SACN_RECEIVER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+//================================
+// sACN (E1.31) LED INPUT
+//================================
+
+// Optional listener for one DMX universe on UDP 5568, unicast or the standard
+// multicast group 239.255.<universe hi>.<universe lo>. Channels map to colors:
+//
+//   faderAddress: 10 x RGB, fader 201 first
+//   keyAddress:   40 x RGB, in EXECUTOR_IDS order (101-110, 201-210, 301-310, 401-410)
+//
+// The UDP callback checks the fixed E1.31 header fields and copies the slots; each
+// LED frame picks up the newest copy (senders run at up to 44 Hz).
+//
+// Merge: the wing's own appearance colors act as a source with wingPriority. A sender
+// with a higher priority replaces them, an equal one is merged highest-takes-precedence
+// per channel, a lower one is ignored. Between senders the highest priority wins.
+// Startup and timeout effects still paint on top. When the sender stops (stream
+// terminated, or no data for 2.5 s) the appearance colors come back.
+
+#define SACN_PORT 5568
+#define SACN_MAX_PRIORITY 200
+#define SACN_FADER_CHANNELS (NUM_FADERS * 3)
+#define SACN_KEY_CHANNELS (NUM_EXECUTORS_TRACKED * 3)
+
+struct SacnStats {
+  bool     live;              // A source is driving the LEDs
+  uint8_t  priority;          // Of the current source
+  uint16_t universe;          // Listening on, 0 when disabled
+  uint32_t packets;           // Accepted data packets
+  uint32_t ignored;           // Not E1.31 data, other universe, preview or non-zero start code
+  uint32_t outOfOrder;        // Late or duplicate sequence numbers
+  uint32_t lowerPriority;     // From another source below the current one
+  uint32_t sourceChanges;
+  uint32_t timeouts;          // Sources lost without a stream-terminated packet
+  char     sourceName[64];    // As sent by the current or last source
+};
+
+//================================
+// FUNCTION DECLARATIONS
+//================================
+
+void setupSacn();                                  // After setupNetwork(), and after a config change
+void sacnLoop();                                   // Keeps the multicast membership current (call from loop)
+void updateSacnInput();                            // Once per LED frame, before rendering
+bool mergeSacnFaderColor(int faderIndex, uint32_t& color);   // true if sACN changed the color
+bool mergeSacnKeyColor(int execIndex, uint32_t& color);
+bool isValidSacnConfig(const SacnConfig& config);
+const SacnStats& getSacnStats();
+
+#endif // SACN_RECEIVER_H
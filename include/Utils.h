@@ -34,6 +34,7 @@ IPAddress stringToIP(const String &str);
 
 // Extract parameter from URL query string
 String getParam(String data, const char* key);
+String urlDecode(const String& s);     // %XX escapes and '+' from form submissions
 
 // Reset Teensy
 void resetTeensy();
@@ -38,6 +38,8 @@ void handleNetworkSettings(String request);
 void handleCalibrationSettings(String request);
 void handleFaderSettings(String request);
 void handleLEDSettingsSave(String request);
+void handleKeyLedMapSave(String request);
+void handleSacnSettingsSave(String request);
 void handleTouchSettings(String request);
 void handleRunCalibration();
 void handleDebugToggle(String requestBody);
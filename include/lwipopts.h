@@ -33,8 +33,12 @@ void qnethernet_hal_check_core_locking(const char *file, int line,
                                        const char *func);
 
 // Memory options
+// EvoFaderWing profile: lwIP's own fixed heap instead of libc malloc, so packet
+// buffers never compete with (or fragment) the application heap. Sized for the
+// web server and the OSC TCP stream sending at the same time (TCP_SND_BUF each)
+// plus UDP OSC output bursts.
 #ifndef MEM_LIBC_MALLOC
-#define MEM_LIBC_MALLOC                        1  /* 0 */
+#define MEM_LIBC_MALLOC                        0  /* 0 */
 #endif  // !MEM_LIBC_MALLOC
 // #define MEM_CUSTOM_ALLOCATOR                   0  /* opt.h sets to 1 if MEM_LIBC_MALLOC */
 // #define MEM_CUSTOM_FREE                        free
@@ -45,7 +49,7 @@ void qnethernet_hal_check_core_locking(const char *file, int line,
 #define MEM_ALIGNMENT                          4  /* 1 */
 #ifndef MEM_SIZE
 // Note: MEM_SIZE is not used if MEM_LIBC_MALLOC is enabled
-#define MEM_SIZE                               24000  /* 1600 */
+#define MEM_SIZE                               32768  /* 1600 */
 #endif  // !MEM_SIZE
 // #define MEMP_OVERFLOW_CHECK                    0
 // #define MEMP_SANITY_CHECK                      0
@@ -57,7 +61,7 @@ void qnethernet_hal_check_core_locking(const char *file, int line,
 // #define LWIP_ALLOW_MEM_FREE_FROM_OTHER_CONTEXT 0
 
 // Internal Memory Pool Sizes
-// #define MEMP_NUM_PBUF                      16
+#define MEMP_NUM_PBUF                      24  /* 16 */
 // #define MEMP_NUM_RAW_PCB                   4
 #ifndef MEMP_NUM_UDP_PCB
 // Increment MEMP_NUM_UDP_PCB by 1 for mDNS, if needed:
@@ -69,7 +73,8 @@ void qnethernet_hal_check_core_locking(const char *file, int line,
 #ifndef MEMP_NUM_TCP_PCB_LISTEN
 // #define MEMP_NUM_TCP_PCB_LISTEN            8
 #endif  // !MEMP_NUM_TCP_PCB_LISTEN
-// #define MEMP_NUM_TCP_SEG                   16
+// Two connections (web + OSC TCP) with a full TCP_SND_QUEUELEN each
+#define MEMP_NUM_TCP_SEG                   32  /* 16 */
 // #define MEMP_NUM_ALTCP_PCB                 MEMP_NUM_TCP_PCB
 // #define MEMP_NUM_REASSDATA                 5
 // #define MEMP_NUM_FRAG_PBUF                 15
@@ -97,7 +102,9 @@ void qnethernet_hal_check_core_locking(const char *file, int line,
 // #define MEMP_NUM_TCPIP_MSG_INPKT           8
 // #define MEMP_NUM_NETDB                     1
 // #define MEMP_NUM_LOCALHOSTLIST             1
-// #define PBUF_POOL_SIZE                     16
+// Receive buffers: a console update tick (exec + color bundle) from two consoles
+// plus web requests, with room for the loop to fall one pass behind
+#define PBUF_POOL_SIZE                     24  /* 16 */
 // #define MEMP_NUM_API_MSG                   MEMP_NUM_TCPIP_MSG_API
 // #define MEMP_NUM_DNS_API_MSG               MEMP_NUM_TCPIP_MSG_API
 // #define MEMP_NUM_SOCKET_SETGETSOCKOPT_DATA MEMP_NUM_TCPIP_MSG_API
@@ -229,8 +236,8 @@ void qnethernet_hal_check_core_locking(const char *file, int line,
 #define TCP_MSS                    ((MTU) - 40)  /* 536 */
 // #define TCP_CALCULATE_EFF_SEND_MSS 1
 // #define LWIP_TCP_RTO_TIME          3000
-#define TCP_SND_BUF                (16 * (TCP_MSS))  /* (2 * TCP_MSS) */
-// #define TCP_SND_QUEUELEN           ((4 * (TCP_SND_BUF) + (TCP_MSS - 1))/(TCP_MSS))
+#define TCP_SND_BUF                (8 * (TCP_MSS))  /* (2 * TCP_MSS) */
+#define TCP_SND_QUEUELEN           ((2 * (TCP_SND_BUF) + (TCP_MSS - 1))/(TCP_MSS))  /* ((4 * (TCP_SND_BUF) + (TCP_MSS - 1))/(TCP_MSS)) */
 /* #define TCP_SNDLOWAT \
    LWIP_MIN(LWIP_MAX(((TCP_SND_BUF)/2), (2 * TCP_MSS) + 1), (TCP_SND_BUF) - 1)*/
 // #define TCP_SNDQUEUELOWAT LWIP_MAX(((TCP_SND_QUEUELEN)/2), 5)
@@ -348,11 +355,12 @@ void qnethernet_hal_check_core_locking(const char *file, int line,
 // #define LWIP_SOCKET_POLL                  1
 
 // Statistics options
+// Counters are shown on the web statistics page (see LwipStats.cpp)
 #ifndef LWIP_STATS
-#define LWIP_STATS         0  /* 1 */
+#define LWIP_STATS         1  /* 1 */
 #endif  // !LWIP_STATS
 #ifndef LWIP_STATS_LARGE
-// #define LWIP_STATS_LARGE   0
+#define LWIP_STATS_LARGE   1  /* 0 */
 #endif  // !LWIP_STATS_LARGE
 // #define LWIP_STATS_DISPLAY 0
 // #define LINK_STATS         1
@@ -371,7 +379,7 @@ void qnethernet_hal_check_core_locking(const char *file, int line,
 // #define IP6_FRAG_STATS     (LWIP_IPV6 && (LWIP_IPV6_FRAG || LWIP_IPV6_REASS))
 // #define MLD6_STATS         (LWIP_IPV6 && LWIP_IPV6_MLD)
 // #define ND6_STATS          (LWIP_IPV6)
-// #define MIB2_STATS         0
+#define MIB2_STATS         1  /* 0, needed for the TCP retransmit count */
 
 // Checksum options
 // #define LWIP_CHECKSUM_CTRL_PER_NETIF 0
@@ -1,11 +1,12 @@
 -- EVOFaderWing v0.3 Lua script for syncing EVOFaderWing using OSC
 -- Sends execUpdate (page + faders + exec status) and colorUpdate for all Execs and Faders
--- OSC sent when data has changed or after autoResendInterval
+-- OSC sent when data has changed or when the FaderWing asks for a resync
 --
 -- Since v0.3 we now track all Executors status and color, including Proxy Execs that are created when expanding Execs
 -- Compatiable with Sequence, Macro, and Plugin objects only (for now)
 --
--- Default autoResendInterval is 300 (15 seconds) 
+-- The FaderWing requests a full snapshot at boot, when its link comes back and when the heartbeat
+-- shows it missed an update, so there is no periodic forced resend
 --
 -- Special thanks to xxpasixx for his pam-osc code which I modified for my project
 -- GPL3
@@ -77,13 +78,18 @@ function main()
 
         -- The speed to check executors
         local tick = 1 / 20 -- 1/20 second = 50ms
-        local resendTick = 0
-        local autoResendInterval = 300 -- ticks (15 seconds at 50ms per tick)
+        local heartbeatTick = 0
+        local heartbeatInterval = 20 -- ticks (1 second), lets the wing fail over to a backup console when this one goes quiet
+        local heartbeatCount = 0
+        local execSeq = 0 -- numbers each /execUpdate and /colorUpdate; the heartbeat carries the latest so the wing can spot a lost one
+        local colorSeq = 0
+        local lastPing = nil -- EvoPing value ("seq,millis,wingId") the wing set through /cmd, answered once with /pong
         -- New packet layouts:
-        --   /execUpdate: page + 10 fader ints + 40 executor status ints
-        --   /colorUpdate: page + 40 color strings (101-410)
-        local execUpdateTypeTag = "," .. string.rep("i", 1 + 10 + #executorsToWatch)
-        local colorUpdateTypeTag = "," .. "i" .. string.rep("s", #executorsToWatch)
+        --   /execUpdate: page + 10 fader ints + 40 executor status ints + update number
+        --   /colorUpdate: page + 40 color strings (101-410) + update number
+        --   /heartbeat: count + latest exec update number + latest color update number
+        local execUpdateTypeTag = "," .. string.rep("i", 1 + 10 + #executorsToWatch) .. "i"
+        local colorUpdateTypeTag = "," .. "i" .. string.rep("s", #executorsToWatch) .. "i"
         local DEBUG_PROXY = false
 
         local function getAppearanceColor(sequence)
@@ -401,23 +407,28 @@ function main()
         end
 
         Printf("start EvoFaderWingv0.3 - fader values/colors + executor status (101-410)")
-        Printf("autoResendInterval: " .. autoResendInterval .. " (every " .. (autoResendInterval / 20) .. " seconds)")
 
         local destPage = 1
         local forceReload = true
 
         while (GetVar(GlobalVars(), "opdateOSC")) do
-            if GetVar(GlobalVars(), "forceReload") == true then
+            -- The wing asks for a resync (boot, link up, missed update, failover) with SetGlobalVariable,
+            -- which stores the string "true"; the snapshot goes out on this tick
+            local reloadVar = GetVar(GlobalVars(), "forceReload")
+            if reloadVar == true or reloadVar == "true" then
                 forceReload = true
                 SetVar(GlobalVars(), "forceReload", false)
             end
 
-            -- Increment resend counter and check for automatic resend 
-            resendTick = resendTick + 1
-            if resendTick >= autoResendInterval then
-                forceReload = true
-                resendTick = 0
-                Printf("Auto force reload triggered (every " .. (autoResendInterval / 20) .. " seconds)")
+            -- Echo the wing's ping so it can measure round trip and link health. The wing id
+            -- goes back too: every wing writes the same variable and hears every pong.
+            local ping = GetVar(GlobalVars(), "EvoPing")
+            if ping ~= nil and ping ~= lastPing then
+                lastPing = ping
+                local seq, sentMs, wingId = string.match(tostring(ping), "^(%d+),(%d+),(%d+)$")
+                if seq then
+                    Cmd('SendOSC ' .. oscEntry .. ' "/pong,iii,' .. seq .. ',' .. sentMs .. ',' .. wingId .. '"')
+                end
             end
 
             local faderDataChanged = false
@@ -428,6 +439,8 @@ function main()
             local myPage = CurrentExecPage()
             if myPage.index ~= destPage then
                 destPage = myPage.index
+                -- Tell the wing first so it can flip to its cached copy of the page while we read executors
+                Cmd('SendOSC ' .. oscEntry .. ' "/updatePage/current,i,' .. destPage .. '"')
                 -- Reset fader values (201-210)
                 for i = 201, 210 do
                     oldValues[i] = 000
@@ -524,6 +537,9 @@ function main()
                     oldExecStatus[execNo] = currentExecStatus[execNo]
                 end
 
+                execSeq = execSeq + 1
+                execMessage = execMessage .. "," .. execSeq
+
                 Cmd('SendOSC ' .. oscEntry .. ' "' .. execMessage .. '"')
                 Printf("Sent exec update: Page " .. destPage .. ".")
             end
@@ -538,12 +554,22 @@ function main()
                     oldColorValues[execNo] = c
                 end
 
+                colorSeq = colorSeq + 1
+                colorMessage = colorMessage .. "," .. colorSeq
+
                 Cmd('SendOSC ' .. oscEntry .. ' "' .. colorMessage .. '"')
                 Printf("Sent color update: Page " .. destPage .. ".")
             end
             
             forceReload = false
 
+            heartbeatTick = heartbeatTick + 1
+            if heartbeatTick >= heartbeatInterval then
+                heartbeatTick = 0
+                heartbeatCount = heartbeatCount + 1
+                Cmd('SendOSC ' .. oscEntry .. ' "/heartbeat,iii,' .. heartbeatCount .. ',' .. execSeq .. ',' .. colorSeq .. '"')
+            end
+
             -- Main loop delay
             coroutine.yield(tick)
         end
@@ -0,0 +1,648 @@
+import argparse
+import base64
+import glob
+import hashlib
+import json
+import os
+import random
+import select
+import socket
+import struct
+import subprocess
+import sys
+import tempfile
+import time
+
+# Capture, synthesize and replay console OSC traffic against a FaderWing, or against the
+# firmware's OSC receive path built for the PC (fuzz/).
+#
+#   capture : listen where the console sends OSC, record every packet with its timestamp
+#             (optionally forwarding to the wing so the desk keeps working while recording)
+#   synth   : write a recording that mimics the Lua plugin (exec + color bundles every 50ms)
+#   replay  : send a recording to the wing over UDP at 1x or faster and report throughput,
+#             drops and latency from the wing's own /stats counters
+#   host-replay : run a recording through the firmware's OSC receive path built for the PC
+#             (fuzz/, no wing needed) and print its counters and handling time
+#   stats   : print the wing's receive counters once
+#   fuzz    : send mutated copies of recorded packets, saving any input that hangs/reboots
+#             the wing or takes too long to handle into a findings directory
+#   regress : send every saved finding once and fail if the wing hangs or is slow on any
+#   corpus  : turn a recording (and saved findings) into inputs for the host fuzzer in fuzz/
+#   tcp-console : stand in for the console on the SLIP/TCP transport: accept the wing's
+#             connection, print what it sends and optionally replay a recording over it
+#
+# Recordings are JSON lines: {"t": seconds since first packet, "data": base64 packet}
+
+# -------------------- CONFIG --------------------
+DEFAULT_WING_PORT = 8000        # netConfig.receivePort default
+STATS_TIMEOUT = 1.0             # seconds to wait for a /stats/rx reply
+NUM_EXECUTORS = 40              # executors per exec/color bundle
+LATENCY_BUCKETS_US = [250, 500, 1000, 2000, 5000, 10000, 20000, 0]  # matches OSC_LATENCY_LIMITS_US
+CORPUS_WINDOW = 8               # corpus: packets per host fuzzer input
+FUZZ_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "fuzz")
+CORPUS_TIME_STEP = 0.05         # corpus: time unit of the record header (TIME_STEP_MS in osc_ingest_fuzzer.cpp)
+SLOW_INPUT_US = 5000            # fuzz/regress: handling time that counts as a slow input
+                                # (exec bundles that move faders block for the move, raise with --slow-us)
+RECOVERY_TIMEOUT = 30.0         # fuzz: seconds to wait for the wing to come back after a hang
+
+# Order of the ints in the /stats/rx reply (see sendOscStatsReply in NetworkOSC.cpp)
+STATS_FIELDS = (["received", "exec", "color", "page", "stats", "other",
+                 "queueDrops", "oversize", "coalesced", "parseFailures", "malformed",
+                 "highWater", "latencyLastUs", "latencyMaxUs"]
+                + [f"lat{i}" for i in range(len(LATENCY_BUCKETS_US))])
+
+
+# ------------------ OSC ENCODING ------------------
+def osc_pad(b):
+    b += b"\0"
+    while len(b) % 4:
+        b += b"\0"
+    return b
+
+
+def osc_message(address, *args):
+    tags = ","
+    payload = b""
+    for a in args:
+        if isinstance(a, int):
+            tags += "i"
+            payload += struct.pack(">i", a)
+        elif isinstance(a, float):
+            tags += "f"
+            payload += struct.pack(">f", a)
+        else:
+            tags += "s"
+            payload += osc_pad(str(a).encode())
+    return osc_pad(address.encode()) + osc_pad(tags.encode()) + payload
+
+
+def osc_parse(data):
+    """Returns (address, [args]) for int/float/string messages, None if not parseable."""
+    try:
+        end = data.index(b"\0")
+        address = data[:end].decode()
+        pos = (end + 4) & ~3
+        end = data.index(b"\0", pos)
+        tags = data[pos:end].decode()
+        pos = (end + 4) & ~3
+        args = []
+        for t in tags[1:]:
+            if t == "i":
+                args.append(struct.unpack(">i", data[pos:pos + 4])[0])
+                pos += 4
+            elif t == "f":
+                args.append(struct.unpack(">f", data[pos:pos + 4])[0])
+                pos += 4
+            elif t == "s":
+                end = data.index(b"\0", pos)
+                args.append(data[pos:end].decode(errors="replace"))
+                pos = (end + 4) & ~3
+            else:
+                return address, args
+        return address, args
+    except (ValueError, struct.error, UnicodeDecodeError):
+        return None
+
+
+# ------------------ RECORDINGS ------------------
+def load_recording(path):
+    records = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line:
+                rec = json.loads(line)
+                records.append((rec["t"], base64.b64decode(rec["data"])))
+    return records
+
+
+def write_record(f, t, data):
+    f.write(json.dumps({"t": round(t, 6), "data": base64.b64encode(data).decode()}) + "\n")
+
+
+def describe(data):
+    parsed = osc_parse(data)
+    return parsed[0] if parsed else "?"
+
+
+# ------------------ WING STATS ------------------
+def query_stats(sock, target):
+    """Ask the wing for its receive counters; returns a dict or None on timeout."""
+    sock.sendto(osc_message("/stats"), target)
+    deadline = time.monotonic() + STATS_TIMEOUT
+    while time.monotonic() < deadline:
+        sock.settimeout(max(0.01, deadline - time.monotonic()))
+        try:
+            data, _ = sock.recvfrom(2048)
+        except socket.timeout:
+            break
+        parsed = osc_parse(data)
+        if parsed and parsed[0] == "/stats/rx":
+            return dict(zip(STATS_FIELDS, parsed[1]))
+    return None
+
+
+def print_stats(stats, title):
+    print(f"[OSC] {title}")
+    for key in STATS_FIELDS:
+        if key.startswith("lat") and key[3:].isdigit():
+            continue
+        print(f"[OSC]   {key:<14} {stats[key]}")
+    print_histogram(stats)
+
+
+def print_histogram(stats):
+    total = sum(stats[f"lat{i}"] for i in range(len(LATENCY_BUCKETS_US)))
+    prev = 0
+    for i, limit in enumerate(LATENCY_BUCKETS_US):
+        n = stats[f"lat{i}"]
+        label = f"{prev}-{limit} us" if limit else f"> {prev} us"
+        pct = (100.0 * n / total) if total else 0.0
+        print(f"[OSC]   {label:<16} {n:>8}  {pct:5.1f}%")
+        prev = limit
+
+
+def stats_delta(before, after):
+    delta = {k: after[k] - before[k] for k in STATS_FIELDS}
+    # Not counters: report the final value
+    for key in ("highWater", "latencyLastUs", "latencyMaxUs"):
+        delta[key] = after[key]
+    return delta
+
+
+# ------------------ MODES ------------------
+def cmd_capture(args):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", args.listen_port))
+    forward = (args.forward, args.forward_port) if args.forward else None
+    print(f"[CAPTURE] Listening on UDP {args.listen_port}, writing {args.out} (Ctrl+C to stop)")
+    if forward:
+        print(f"[CAPTURE] Forwarding to {forward[0]}:{forward[1]}")
+
+    count = 0
+    start = None
+    with open(args.out, "w") as f:
+        try:
+            while args.duration <= 0 or start is None or time.monotonic() - start < args.duration:
+                sock.settimeout(0.5)
+                try:
+                    data, _ = sock.recvfrom(65535)
+                except socket.timeout:
+                    continue
+                now = time.monotonic()
+                if start is None:
+                    start = now
+                write_record(f, now - start, data)
+                if forward:
+                    sock.sendto(data, forward)
+                count += 1
+                if args.verbose:
+                    print(f"[CAPTURE] {now - start:9.3f}s {len(data):5d}B {describe(data)}")
+        except KeyboardInterrupt:
+            pass
+    print(f"[CAPTURE] Recorded {count} packets")
+
+
+def cmd_synth(args):
+    """Same shape as EvoFaderWingOSC.lua: one exec and one color bundle per tick."""
+    rng = random.Random(args.seed)
+    faders = [0] * 10
+    statuses = [1] * NUM_EXECUTORS
+    colors = [f"{rng.randrange(256)};{rng.randrange(256)};{rng.randrange(256)};255" for _ in range(NUM_EXECUTORS)]
+    page = 1
+    tick = args.tick_ms / 1000.0
+    ticks = int(args.duration / tick)
+
+    with open(args.out, "w") as f:
+        for n in range(ticks):
+            t = n * tick
+            if rng.random() < args.change_rate:
+                i = rng.randrange(10)
+                faders[i] = max(0, min(100, faders[i] + rng.randint(-20, 20)))
+            if rng.random() < args.change_rate:
+                statuses[rng.randrange(NUM_EXECUTORS)] = rng.randint(0, 2)
+            if rng.random() < args.change_rate / 4:
+                colors[rng.randrange(NUM_EXECUTORS)] = f"{rng.randrange(256)};{rng.randrange(256)};{rng.randrange(256)};255"
+            if args.page_every and n and n % args.page_every == 0:
+                page = page % 4 + 1
+                write_record(f, t, osc_message("/updatePage/current", page))
+            write_record(f, t, osc_message("/execUpdate", page, *faders, *statuses))
+            write_record(f, t + 0.001, osc_message("/colorUpdate", page, *colors))
+    print(f"[SYNTH] Wrote {ticks * 2} packets ({args.duration}s at {args.tick_ms}ms) to {args.out}")
+
+
+def cmd_replay(args):
+    records = load_recording(args.recording)
+    if not records:
+        print("[REPLAY] Recording is empty")
+        sys.exit(1)
+
+    target = (args.target, args.port)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", 0))
+
+    before = query_stats(sock, target)
+    if before is None:
+        print("[REPLAY] No /stats/rx reply, only sender figures will be shown")
+
+    sent = 0
+    sent_bytes = 0
+    worst_slip = 0.0
+    start = time.monotonic()
+    for loop in range(args.loops):
+        loop_start = time.monotonic()
+        for t, data in records:
+            due = loop_start + t / args.speed
+            wait = due - time.monotonic()
+            if wait > 0:
+                time.sleep(wait)
+            else:
+                worst_slip = max(worst_slip, -wait)
+            sock.sendto(data, target)
+            sent += 1
+            sent_bytes += len(data)
+    elapsed = time.monotonic() - start
+
+    time.sleep(args.settle)
+    after = query_stats(sock, target)
+
+    print(f"[REPLAY] Sent {sent} packets / {sent_bytes} bytes in {elapsed:.2f}s "
+          f"({sent / elapsed:.0f} pkt/s, {sent_bytes / elapsed / 1024:.0f} KiB/s) at {args.speed}x")
+    print(f"[REPLAY] Worst sender slip {worst_slip * 1000:.1f} ms")
+
+    if before is not None and after is not None:
+        delta = stats_delta(before, after)
+        received = delta["received"]
+        lost_on_wire = sent - (received - delta["stats"])  # the /stats requests are counted too
+        print_stats(delta, "Wing counters during replay")
+        print(f"[REPLAY] Not seen by the wing: {max(0, lost_on_wire)}")
+        dropped = delta["queueDrops"] + delta["oversize"]
+        if received:
+            print(f"[REPLAY] Dropped in queue: {dropped} ({100.0 * dropped / received:.2f}%), "
+                  f"coalesced colors: {delta['coalesced']}")
+
+
+def cmd_stats(args):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", 0))
+    stats = query_stats(sock, (args.target, args.port))
+    if stats is None:
+        print("[OSC] No /stats/rx reply")
+        sys.exit(1)
+    print_stats(stats, f"Wing counters since boot ({args.target})")
+
+
+# ------------------ FUZZING ------------------
+INTERESTING_INTS = [0, 1, 2, 3, -1, 100, 101, 255, 256, 9999, 10000, 0x7FFFFFFF, -0x80000000]
+
+
+def mutate(rng, data):
+    data = bytearray(data)
+    for _ in range(rng.randint(1, 4)):
+        choice = rng.randrange(7)
+        if choice == 0 and data:                       # flip a bit
+            i = rng.randrange(len(data))
+            data[i] ^= 1 << rng.randrange(8)
+        elif choice == 1 and len(data) >= 4:           # overwrite an aligned word
+            i = rng.randrange(len(data) // 4) * 4
+            data[i:i + 4] = struct.pack(">i", rng.choice(INTERESTING_INTS))
+        elif choice == 2 and data:                     # truncate
+            del data[rng.randrange(len(data)):]
+        elif choice == 3:                              # append junk
+            data += bytes(rng.randrange(256) for _ in range(rng.randint(1, 64)))
+        elif choice == 4 and b"," in data:             # rewrite a type tag
+            i = data.index(b",") + 1 + rng.randrange(8)
+            if i < len(data) and data[i]:
+                data[i] = ord(rng.choice("isfbTFNx"))
+        elif choice == 5:                              # long string or long digit run
+            i = rng.randrange(len(data) + 1)
+            data[i:i] = (b"9" if rng.random() < 0.5 else b";") * rng.randint(16, 1200)
+        elif choice == 6 and data:                     # zero a range
+            i = rng.randrange(len(data))
+            data[i:i + rng.randint(1, 16)] = bytes(min(16, len(data) - i))
+    return bytes(data)
+
+
+def probe_input(sock, target, data, slow_us):
+    """Send one input and return ("ok"|"slow"|"hang"|"reboot", stats)."""
+    before = query_stats(sock, target)
+    sock.sendto(data, target)
+    after = query_stats(sock, target)
+    if after is None:
+        return "hang", None
+    if before is not None and after["received"] < before["received"]:
+        return "reboot", after
+    # The /stats reply reports the packet handled just before it, which is our input
+    if after["latencyLastUs"] > slow_us:
+        return "slow", after
+    return "ok", after
+
+
+def save_finding(directory, kind, data):
+    os.makedirs(directory, exist_ok=True)
+    name = f"{kind}-{hashlib.sha1(data).hexdigest()[:12]}.bin"
+    path = os.path.join(directory, name)
+    with open(path, "wb") as f:
+        f.write(data)
+    return path
+
+
+def wait_for_wing(sock, target):
+    deadline = time.monotonic() + RECOVERY_TIMEOUT
+    while time.monotonic() < deadline:
+        if query_stats(sock, target) is not None:
+            return True
+    return False
+
+
+def cmd_fuzz(args):
+    seeds = [data for _, data in load_recording(args.recording)]
+    seeds += [open(p, "rb").read() for p in sorted(glob.glob(os.path.join(args.findings, "*.bin")))]
+    if not seeds:
+        print("[FUZZ] No seed packets")
+        sys.exit(1)
+
+    rng = random.Random(args.seed)
+    target = (args.target, args.port)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", 0))
+    if query_stats(sock, target) is None:
+        print("[FUZZ] Wing does not answer /stats")
+        sys.exit(1)
+
+    findings = 0
+    start = time.monotonic()
+    for n in range(1, args.iterations + 1):
+        data = mutate(rng, rng.choice(seeds))
+        result, stats = probe_input(sock, target, data, args.slow_us)
+        if result != "ok":
+            path = save_finding(args.findings, result, data)
+            findings += 1
+            detail = f" ({stats['latencyLastUs']} us)" if result == "slow" else ""
+            print(f"[FUZZ] {result}{detail} on input {n}, saved {path}")
+            if result == "hang" and not wait_for_wing(sock, target):
+                print("[FUZZ] Wing did not come back, stopping")
+                break
+        if n % 100 == 0:
+            print(f"[FUZZ] {n} inputs, {findings} findings, {n / (time.monotonic() - start):.0f} inputs/s")
+    print(f"[FUZZ] Done, {findings} findings in {args.findings}")
+
+
+def cmd_regress(args):
+    paths = sorted(glob.glob(os.path.join(args.findings, "*.bin")))
+    if not paths:
+        print(f"[REGRESS] No findings in {args.findings}")
+        return
+
+    target = (args.target, args.port)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", 0))
+    failures = 0
+    for path in paths:
+        with open(path, "rb") as f:
+            result, stats = probe_input(sock, target, f.read(), args.slow_us)
+        print(f"[REGRESS] {os.path.basename(path):<32} {result}")
+        if result != "ok":
+            failures += 1
+            if result == "hang" and not wait_for_wing(sock, target):
+                print("[REGRESS] Wing did not come back, stopping")
+                break
+    print(f"[REGRESS] {len(paths) - failures}/{len(paths)} passed")
+    sys.exit(1 if failures else 0)
+
+
+# ------------------ HOST FUZZER CORPUS ------------------
+def corpus_record(data, dt=0, sender=0):
+    """One record of a fuzz/osc_ingest_fuzzer.cpp input: flags, big-endian length, packet."""
+    steps = max(0, min(63, round(dt / CORPUS_TIME_STEP)))
+    data = data[:0xFFFF]
+    return struct.pack(">BH", (steps << 2) | (sender & 3), len(data)) + data
+
+
+def cmd_corpus(args):
+    os.makedirs(args.out, exist_ok=True)
+    written = 0
+    if args.recording:
+        records = load_recording(args.recording)
+        for start in range(0, len(records), args.window):
+            window = records[start:start + args.window]
+            prev = window[0][0]
+            data = b""
+            for t, packet in window:
+                data += corpus_record(packet, t - prev)
+                prev = t
+            save_finding(args.out, "seed", data)
+            written += 1
+    # Findings from fuzz mode are single packets from the primary console
+    paths = sorted(glob.glob(os.path.join(args.findings, "*.bin"))) if args.findings else []
+    for path in paths:
+        with open(path, "rb") as f:
+            save_finding(args.out, "finding", corpus_record(f.read(), 0))
+        written += 1
+    print(f"[CORPUS] Wrote {written} inputs to {args.out}")
+
+
+def cmd_host_replay(args):
+    records = load_recording(args.recording)
+    if not records:
+        print("[HOST] Recording is empty")
+        sys.exit(1)
+
+    make = ["make", "-C", FUZZ_DIR, "osc_host_replay"]
+    if args.liteosc:
+        make.append(f"LITEOSC_DIR={os.path.abspath(args.liteosc)}")
+    if subprocess.run(make, stdout=subprocess.DEVNULL).returncode != 0:
+        print("[HOST] Host build failed (build the firmware once so PlatformIO fetches LiteOSCParser, or pass --liteosc)")
+        sys.exit(1)
+
+    # Same schedule as replay: microseconds since the previous packet, then the packet
+    with tempfile.NamedTemporaryFile(suffix=".bin", delete=False) as f:
+        prev = 0.0
+        for loop in range(args.loops):
+            offset = loop * (records[-1][0] + 0.05)
+            for t, data in records:
+                gap_us = max(0, round((offset + t - prev) / args.speed * 1e6))
+                prev = offset + t
+                f.write(struct.pack(">IH", min(gap_us, 0xFFFFFFFF), len(data)) + data[:0xFFFF])
+        path = f.name
+    try:
+        result = subprocess.run([os.path.join(FUZZ_DIR, "osc_host_replay"), path])
+    finally:
+        os.unlink(path)
+    sys.exit(result.returncode)
+
+
+# ------------------ TCP (SLIP) STAND-IN ------------------
+SLIP_END, SLIP_ESC, SLIP_ESC_END, SLIP_ESC_ESC = 0xC0, 0xDB, 0xDC, 0xDD
+
+
+def slip_encode(data):
+    out = bytearray([SLIP_END])
+    for b in data:
+        if b == SLIP_END:
+            out += bytes([SLIP_ESC, SLIP_ESC_END])
+        elif b == SLIP_ESC:
+            out += bytes([SLIP_ESC, SLIP_ESC_ESC])
+        else:
+            out.append(b)
+    out.append(SLIP_END)
+    return bytes(out)
+
+
+class SlipDecoder:
+    def __init__(self):
+        self.frame = bytearray()
+        self.escaped = False
+
+    def feed(self, data):
+        frames = []
+        for b in data:
+            if b == SLIP_END:
+                if self.frame:
+                    frames.append(bytes(self.frame))
+                self.frame = bytearray()
+                self.escaped = False
+            elif self.escaped:
+                self.frame.append(SLIP_END if b == SLIP_ESC_END else SLIP_ESC if b == SLIP_ESC_ESC else b)
+                self.escaped = False
+            elif b == SLIP_ESC:
+                self.escaped = True
+            else:
+                self.frame.append(b)
+        return frames
+
+
+def cmd_tcp_console(args):
+    records = load_recording(args.replay) if args.replay else []
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind(("0.0.0.0", args.listen_port))
+    server.listen(1)
+    print(f"[TCP] Waiting for the wing on TCP {args.listen_port} (set OSC Send Port to this and transport to TCP)")
+
+    try:
+        while True:
+            conn, addr = server.accept()
+            conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            print(f"[TCP] Wing connected from {addr[0]}:{addr[1]}")
+            decoder = SlipDecoder()
+            frames = 0
+            reads = 0
+            start = time.monotonic()
+            next_record = 0
+            while True:
+                now = time.monotonic()
+                # Replay the recording over the stream on its own timeline
+                while next_record < len(records) and now - start >= records[next_record][0] / args.speed:
+                    conn.sendall(slip_encode(records[next_record][1]))
+                    next_record += 1
+                    if next_record == len(records) and args.loop:
+                        next_record = 0
+                        start = now
+
+                ready, _, _ = select.select([conn], [], [], 0.005)
+                if not ready:
+                    continue
+                data = conn.recv(4096)
+                if not data:
+                    break
+                reads += 1
+                for frame in decoder.feed(data):
+                    frames += 1
+                    parsed = osc_parse(frame)
+                    if parsed:
+                        print(f"[TCP] {parsed[0]} {parsed[1]}")
+                    else:
+                        print(f"[TCP] unparseable frame ({len(frame)} bytes)")
+            conn.close()
+            elapsed = time.monotonic() - start
+            print(f"[TCP] Wing disconnected after {elapsed:.1f}s: {frames} messages in {reads} reads, "
+                  f"{next_record} recorded packets sent")
+    except KeyboardInterrupt:
+        pass
+    server.close()
+
+
+# ------------------ MAIN ------------------
+def main():
+    parser = argparse.ArgumentParser(description="Capture and replay OSC traffic for the EvoFaderWing")
+    sub = parser.add_subparsers(dest="mode", required=True)
+
+    p = sub.add_parser("capture", help="record OSC sent by the console")
+    p.add_argument("out")
+    p.add_argument("--listen-port", type=int, default=DEFAULT_WING_PORT)
+    p.add_argument("--forward", help="wing IP to forward packets to while capturing")
+    p.add_argument("--forward-port", type=int, default=DEFAULT_WING_PORT)
+    p.add_argument("--duration", type=float, default=0, help="seconds, 0 = until Ctrl+C")
+    p.add_argument("-v", "--verbose", action="store_true")
+    p.set_defaults(func=cmd_capture)
+
+    p = sub.add_parser("synth", help="generate plugin-like traffic without a console")
+    p.add_argument("out")
+    p.add_argument("--duration", type=float, default=60)
+    p.add_argument("--tick-ms", type=float, default=50)
+    p.add_argument("--change-rate", type=float, default=0.3, help="chance per tick of a fader/status change")
+    p.add_argument("--page-every", type=int, default=0, help="page change every N ticks, 0 = never")
+    p.add_argument("--seed", type=int, default=1)
+    p.set_defaults(func=cmd_synth)
+
+    p = sub.add_parser("replay", help="send a recording to the wing")
+    p.add_argument("recording")
+    p.add_argument("target", help="wing IP")
+    p.add_argument("--port", type=int, default=DEFAULT_WING_PORT)
+    p.add_argument("--speed", type=float, default=1.0, help="time scale, 4 = four times faster")
+    p.add_argument("--loops", type=int, default=1)
+    p.add_argument("--settle", type=float, default=0.5, help="seconds to wait before reading stats")
+    p.set_defaults(func=cmd_replay)
+
+    p = sub.add_parser("host-replay", help="run a recording through the firmware's OSC path on this PC")
+    p.add_argument("recording")
+    p.add_argument("--speed", type=float, default=1.0, help="time scale, 4 = four times faster")
+    p.add_argument("--loops", type=int, default=1)
+    p.add_argument("--liteosc", help="LiteOSCParser source folder, default the PlatformIO one")
+    p.set_defaults(func=cmd_host_replay)
+
+    p = sub.add_parser("stats", help="print the wing's receive counters")
+    p.add_argument("target", help="wing IP")
+    p.add_argument("--port", type=int, default=DEFAULT_WING_PORT)
+    p.set_defaults(func=cmd_stats)
+
+    p = sub.add_parser("fuzz", help="send mutated packets and save inputs that hang or slow the wing")
+    p.add_argument("recording", help="seed recording (capture or synth output)")
+    p.add_argument("target", help="wing IP")
+    p.add_argument("--port", type=int, default=DEFAULT_WING_PORT)
+    p.add_argument("--iterations", type=int, default=1000)
+    p.add_argument("--findings", default="osc_findings", help="directory for saved inputs, also used as extra seeds")
+    p.add_argument("--seed", type=int, default=1)
+    p.add_argument("--slow-us", type=int, default=SLOW_INPUT_US)
+    p.set_defaults(func=cmd_fuzz)
+
+    p = sub.add_parser("regress", help="re-send saved fuzz findings and check the wing handles them")
+    p.add_argument("target", help="wing IP")
+    p.add_argument("--port", type=int, default=DEFAULT_WING_PORT)
+    p.add_argument("--findings", default="osc_findings")
+    p.add_argument("--slow-us", type=int, default=SLOW_INPUT_US)
+    p.set_defaults(func=cmd_regress)
+
+    p = sub.add_parser("corpus", help="write host fuzzer inputs (fuzz/) from a recording and saved findings")
+    p.add_argument("out", help="corpus directory, e.g. fuzz/corpus")
+    p.add_argument("--recording", help="capture or synth output")
+    p.add_argument("--findings", help="directory of packets saved by fuzz mode")
+    p.add_argument("--window", type=int, default=CORPUS_WINDOW, help="packets per input")
+    p.set_defaults(func=cmd_corpus)
+
+    p = sub.add_parser("tcp-console", help="act as the console on the TCP (SLIP) transport")
+    p.add_argument("--listen-port", type=int, default=9000, help="the wing's OSC send port")
+    p.add_argument("--replay", help="recording to send to the wing over the connection")
+    p.add_argument("--speed", type=float, default=1.0)
+    p.add_argument("--loop", action="store_true", help="repeat the recording until the wing disconnects")
+    p.set_defaults(func=cmd_tcp_console)
+
+    args = parser.parse_args()
+    if getattr(args, "speed", 1.0) <= 0:
+        parser.error("--speed must be positive")
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
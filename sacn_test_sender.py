@@ -0,0 +1,149 @@
+import argparse
+import colorsys
+import socket
+import struct
+import time
+import uuid
+
+# Send a test sACN (E1.31) universe to the FaderWing's sACN LED input.
+#
+#   rainbow : hue sweep across the faders and keys
+#   chase   : one lit fader and key at a time
+#   solid   : every fader and key the same color (--color)
+#
+# Sends to the standard multicast group 239.255.<hi>.<lo> unless --target is given.
+# Ctrl+C sends stream-terminated packets so the wing returns to its appearance colors
+# right away instead of after the 2.5 s data-loss timeout. Use --priority and a second
+# instance with another --name to try the priority merge.
+
+# -------------------- CONFIG --------------------
+SACN_PORT = 5568
+NUM_FADERS = 10
+NUM_KEYS = 40
+DEFAULT_FADER_ADDRESS = 1    # SACN_DEFAULT_FADER_ADDRESS
+DEFAULT_KEY_ADDRESS = 31     # SACN_DEFAULT_KEY_ADDRESS
+DEFAULT_RATE = 44            # Packets per second, the DMX refresh ceiling
+TERMINATE_PACKETS = 3        # E1.31 6.2.6: stream-terminated is sent three times
+
+ACN_PACKET_ID = b"ASC-E1.17\0\0\0"
+VECTOR_ROOT_E131_DATA = 0x00000004
+VECTOR_E131_DATA_PACKET = 0x00000002
+VECTOR_DMP_SET_PROPERTY = 0x02
+OPTION_STREAM_TERMINATED = 0x40
+
+
+# ------------------ E1.31 ENCODING ------------------
+def flags_length(length):
+    return 0x7000 | length
+
+
+def e131_packet(cid, name, universe, priority, sequence, slots, options=0):
+    slots = bytes(slots)
+    dmp = struct.pack(">HBBHHH", flags_length(10 + 1 + len(slots)), VECTOR_DMP_SET_PROPERTY,
+                      0xA1, 0x0000, 0x0001, 1 + len(slots)) + b"\0" + slots
+    framing = struct.pack(">HI", flags_length(77 + len(dmp)), VECTOR_E131_DATA_PACKET)
+    framing += name.encode()[:63].ljust(64, b"\0")
+    framing += struct.pack(">BHBBH", priority, 0, sequence, options, universe) + dmp
+    root = struct.pack(">HI", flags_length(22 + len(framing)), VECTOR_ROOT_E131_DATA) + cid + framing
+    return struct.pack(">HH", 0x0010, 0x0000) + ACN_PACKET_ID + root
+
+
+def multicast_group(universe):
+    return f"239.255.{universe >> 8}.{universe & 0xFF}"
+
+
+# ------------------ PATTERNS ------------------
+def rgb(h, v=1.0):
+    r, g, b = colorsys.hsv_to_rgb(h % 1.0, 1.0, v)
+    return [int(r * 255), int(g * 255), int(b * 255)]
+
+
+def pattern_colors(pattern, t, count, color):
+    if pattern == "solid":
+        return [color] * count
+    if pattern == "chase":
+        lit = int(t * 8) % count
+        return [color if i == lit else [0, 0, 0] for i in range(count)]
+    return [rgb(t * 0.2 + i / count) for i in range(count)]
+
+
+def build_universe(args, t):
+    slots = bytearray(512)
+    for address, count in ((args.fader_address, NUM_FADERS), (args.key_address, NUM_KEYS)):
+        if address == 0:
+            continue
+        for i, c in enumerate(pattern_colors(args.pattern, t, count, args.color)):
+            start = address - 1 + i * 3
+            slots[start:start + 3] = bytes(c)
+    return slots
+
+
+def parse_color(text):
+    text = text.lstrip("#")
+    if len(text) != 6:
+        raise argparse.ArgumentTypeError("color must be RRGGBB")
+    return [int(text[i:i + 2], 16) for i in (0, 2, 4)]
+
+
+# ------------------ MAIN ------------------
+def main():
+    parser = argparse.ArgumentParser(description="Send a test sACN universe to the EvoFaderWing")
+    parser.add_argument("--universe", type=int, default=1)
+    parser.add_argument("--target", help="wing IP for unicast, default is the universe's multicast group")
+    parser.add_argument("--interface", help="local IP to send multicast from")
+    parser.add_argument("--pattern", choices=("rainbow", "chase", "solid"), default="rainbow")
+    parser.add_argument("--color", type=parse_color, default=parse_color("FF0000"), help="RRGGBB for solid and chase")
+    parser.add_argument("--priority", type=int, default=100, help="0-200")
+    parser.add_argument("--rate", type=float, default=DEFAULT_RATE, help="packets per second")
+    parser.add_argument("--fader-address", type=int, default=DEFAULT_FADER_ADDRESS, help="0 = leave faders out")
+    parser.add_argument("--key-address", type=int, default=DEFAULT_KEY_ADDRESS, help="0 = leave keys out")
+    parser.add_argument("--name", default="sacn_test_sender")
+    parser.add_argument("--duration", type=float, default=0, help="seconds, 0 = until Ctrl+C")
+    args = parser.parse_args()
+
+    if not 1 <= args.universe <= 63999:
+        parser.error("--universe must be 1-63999")
+    if not 0 <= args.priority <= 200:
+        parser.error("--priority must be 0-200")
+    if args.rate <= 0:
+        parser.error("--rate must be positive")
+    if not 0 <= args.fader_address <= 512 - NUM_FADERS * 3 + 1:
+        parser.error("--fader-address does not fit the universe")
+    if not 0 <= args.key_address <= 512 - NUM_KEYS * 3 + 1:
+        parser.error("--key-address does not fit the universe")
+
+    dest = (args.target or multicast_group(args.universe), SACN_PORT)
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 1)
+    if args.interface:
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_IF, socket.inet_aton(args.interface))
+
+    cid = uuid.uuid4().bytes
+    sequence = 0
+    sent = 0
+    start = time.monotonic()
+    next_send = start
+    print(f"Sending universe {args.universe} ({args.pattern}, priority {args.priority}) to {dest[0]}:{dest[1]} at {args.rate:g} Hz")
+
+    slots = bytearray(512)
+    try:
+        while args.duration <= 0 or time.monotonic() - start < args.duration:
+            slots = build_universe(args, time.monotonic() - start)
+            sock.sendto(e131_packet(cid, args.name, args.universe, args.priority, sequence, slots), dest)
+            sequence = (sequence + 1) & 0xFF
+            sent += 1
+            next_send += 1.0 / args.rate
+            time.sleep(max(0.0, next_send - time.monotonic()))
+    except KeyboardInterrupt:
+        pass
+
+    for _ in range(TERMINATE_PACKETS):
+        sock.sendto(e131_packet(cid, args.name, args.universe, args.priority, sequence, slots,
+                                OPTION_STREAM_TERMINATED), dest)
+        sequence = (sequence + 1) & 0xFF
+    print(f"{sent} packets sent, stream terminated")
+    sock.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,129 @@
+// ColorMath.cpp
+
+#include "ColorMath.h"
+#include <math.h>
+
+//================================
+// TABLES
+//================================
+
+// ceil(2^24 / m): (c * brightness * table[m]) >> 24 == c * brightness / m for every
+// 8-bit c <= m and brightness, checked exhaustively on the host
+struct ReciprocalTable {
+  uint32_t value[256];
+  constexpr ReciprocalTable() : value() {
+    for (uint32_t m = 1; m < 256; m++) {
+      value[m] = ((1UL << 24) + m - 1) / m;
+    }
+  }
+};
+
+static constexpr ReciprocalTable kReciprocal;
+
+// Perceptual level for each linear 8-bit brightness, and linear brightness at each
+// 1/256 step of perceptual level (interpolated in between)
+static uint16_t perceptualFromLevel8[256];
+static uint16_t linearFromLevel[257];
+
+// Every 8-bit threshold once, in bit-reversed order: frac > threshold holds in exactly frac
+// of 256 frames, and any aligned run of 2^k frames is already within 1/2^k of that
+struct DitherTable {
+  uint8_t value[256];
+  constexpr DitherTable() : value() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t r = 0;
+      for (uint32_t bit = 0; bit < 8; bit++) {
+        r |= ((i >> bit) & 1) << (7 - bit);
+      }
+      value[i] = (uint8_t)r;
+    }
+  }
+};
+
+static constexpr DitherTable kDitherThresholds;
+
+void initGammaTables() {
+  for (int i = 0; i < 256; i++) {
+    perceptualFromLevel8[i] = (uint16_t)(powf(i / 255.0f, 1.0f / LED_GAMMA) * 65535.0f + 0.5f);
+  }
+  for (int i = 0; i <= 256; i++) {
+    linearFromLevel[i] = (uint16_t)(powf(i / 256.0f, LED_GAMMA) * 65535.0f + 0.5f);
+  }
+}
+
+//================================
+// SCALING
+//================================
+
+static inline uint8_t max3(uint8_t r, uint8_t g, uint8_t b) {
+  const uint8_t rg = (r > g) ? r : g;
+  return (rg > b) ? rg : b;
+}
+
+uint32_t scaleColorToBrightness(uint8_t r, uint8_t g, uint8_t b, uint8_t brightness) {
+  const uint8_t cmax = max3(r, g, b);
+  if (cmax == 0) {
+    return 0;   // Black stays black regardless of brightness
+  }
+
+  const uint64_t k = (uint64_t)brightness * kReciprocal.value[cmax];
+  const uint32_t r1 = (uint32_t)((r * k) >> 24);
+  const uint32_t g1 = (uint32_t)((g * k) >> 24);
+  const uint32_t b1 = (uint32_t)((b * k) >> 24);
+  return (r1 << 16) | (g1 << 8) | b1;
+}
+
+void scaleColorToBrightness16(uint8_t r, uint8_t g, uint8_t b, uint16_t brightness, uint16_t out[3]) {
+  const uint8_t cmax = max3(r, g, b);
+  if (cmax == 0) {
+    out[0] = out[1] = out[2] = 0;
+    return;
+  }
+
+  const uint64_t k = (uint64_t)brightness * kReciprocal.value[cmax];
+  out[0] = (uint16_t)((r * k) >> 24);
+  out[1] = (uint16_t)((g * k) >> 24);
+  out[2] = (uint16_t)((b * k) >> 24);
+}
+
+void scaleColor16(uint8_t r, uint8_t g, uint8_t b, uint8_t scale, uint16_t out[3]) {
+  // (x << 8) / 255 as a multiply: exact for x <= 255 * 255
+  out[0] = (uint16_t)((((uint64_t)(r * scale) << 8) * 0x80808081ULL) >> 39);
+  out[1] = (uint16_t)((((uint64_t)(g * scale) << 8) * 0x80808081ULL) >> 39);
+  out[2] = (uint16_t)((((uint64_t)(b * scale) << 8) * 0x80808081ULL) >> 39);
+}
+
+//================================
+// GAMMA AND DITHERING
+//================================
+
+uint16_t perceptualLevel(uint8_t brightness) {
+  return perceptualFromLevel8[brightness];
+}
+
+uint16_t linearFromPerceptual(uint16_t level) {
+  const uint8_t index = level >> 8;
+  const uint32_t frac = level & 0xFF;
+  const uint32_t a = linearFromLevel[index];
+  const uint32_t b = linearFromLevel[index + 1];
+  return (uint16_t)(a + (((b - a) * frac) >> 8));
+}
+
+bool needsDither(const uint16_t channels[3]) {
+  const uint16_t frac = (channels[0] | channels[1] | channels[2]) & 0xFF;
+  return channels[0] < (LED_DITHER_BELOW_LEVEL << 8) && channels[1] < (LED_DITHER_BELOW_LEVEL << 8) &&
+         channels[2] < (LED_DITHER_BELOW_LEVEL << 8) && frac != 0;
+}
+
+uint32_t ditherColor16(const uint16_t channels[3], uint8_t phase) {
+  const uint8_t threshold = kDitherThresholds.value[phase];
+  uint32_t color = 0;
+  for (int c = 0; c < 3; c++) {
+    uint32_t v = channels[c] >> 8;
+    if ((channels[c] & 0xFF) > threshold && v < 255) {
+      v++;
+    }
+    color = (color << 8) | v;
+  }
+  return color;
+}
@@ -45,7 +45,8 @@ FaderConfig Fconfig = {
   .fadeTime = 500,
   .serialDebug = debugMode,
   .sendKeystrokes = false,
-  .useLevelPixels = false
+  .useLevelPixels = false,
+  .ditherDimColors = false
 
 };
 
@@ -60,6 +61,31 @@ ExecConfig execConfig = {
   .reserved = {0, 0}
 };
 
+// Key LED map defaults for the stock wiring. Physical strip order for the exec keys
+// (serpentine): 401-410, 310-301, 201-210, 110-101
+const KeyLedMap DEFAULT_KEY_LED_MAP = {{
+  // 101-110 (bottom row, reversed)
+  {78, 2, 0}, {76, 2, 0}, {74, 2, 0}, {72, 2, 0}, {70, 2, 0}, {68, 2, 0}, {66, 2, 0}, {64, 2, 0}, {62, 2, 0}, {60, 2, 0},
+  // 201-210
+  {40, 2, 0}, {42, 2, 0}, {44, 2, 0}, {46, 2, 0}, {48, 2, 0}, {50, 2, 0}, {52, 2, 0}, {54, 2, 0}, {56, 2, 0}, {58, 2, 0},
+  // 301-310 (reversed). 304-310 share pixel 32 as in the original table; 310 owns it
+  {38, 2, 0}, {36, 2, 0}, {34, 2, 0}, {32, 2, 0}, {32, 2, 0}, {32, 2, 0}, {32, 2, 0}, {32, 2, 0}, {32, 2, 0}, {32, 2, 0},
+  // 401-410 (top row)
+  {0, 2, 0}, {3, 2, 0}, {6, 2, 0}, {9, 2, 0}, {13, 2, 0}, {18, 2, 0}, {21, 2, 0}, {24, 2, 0}, {27, 2, 0}, {30, 2, 0}
+}};
+
+KeyLedMap keyLedMap = DEFAULT_KEY_LED_MAP;
+
+// sACN input defaults (off until enabled on the LED settings page)
+SacnConfig sacnConfig = {
+  .enabled = false,
+  .wingPriority = SACN_DEFAULT_WING_PRIORITY,
+  .universe = SACN_DEFAULT_UNIVERSE,
+  .faderAddress = SACN_DEFAULT_FADER_ADDRESS,
+  .keyAddress = SACN_DEFAULT_KEY_ADDRESS,
+  .reserved = {0, 0}
+};
+
 //================================
 // NETWORK CONFIGURATION
 //================================
@@ -72,7 +98,12 @@ NetworkConfig netConfig = {
   IPAddress(192, 168, 0, 10),     // sendToIP (OSC target)
   8000,                            // receivePort (OSC listening)
   9000,                            // sendPort (OSC destination)
-  true                             // useDHCP (fallback to static if false)
+  true,                            // useDHCP (fallback to static if false)
+  IPAddress(239, 1, 1, 1),         // multicastIP (OSC group)
+  false,                           // useMulticast
+  IPAddress(192, 168, 0, 11),      // backupIP (backup console)
+  false,                           // useBackup
+  OSC_TRANSPORT_UDP                // oscTransport
 };
 
 // Network reset check
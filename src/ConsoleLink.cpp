@@ -0,0 +1,299 @@
+// ConsoleLink.cpp
+
+#include "ConsoleLink.h"
+#include "NetworkOSC.h"
+#include "OLED.h"
+#include "Utils.h"
+#include <stdio.h>
+
+//================================
+// SETTINGS
+//================================
+
+// Round trips include up to one plugin tick (50ms) of polling delay. Every ping is a command
+// on the console, so liveness comes from the plugin's heartbeat and pings only go out when a
+// write needs confirming, plus one now and then to keep the round trip current.
+static constexpr uint32_t LINK_IDLE_PING_INTERVAL_MS = 30000;
+static constexpr uint32_t LINK_DEGRADED_AGE_MS = 2500;     // Two heartbeats missed
+static constexpr uint32_t LINK_LOST_AGE_MS = 5000;
+static constexpr uint32_t LINK_SLOW_RTT_MS = 250;
+static constexpr uint32_t LINK_HIGH_JITTER_MS = 100;
+static constexpr uint32_t LINK_MAX_RTT_MS = 60000;         // Anything longer is a stale or foreign pong
+static constexpr uint32_t LINK_TIMESTAMP_MASK = 0x7FFFFFFF; // Timestamps travel as positive OSC ints
+static constexpr uint32_t LINK_RESYNC_MIN_INTERVAL_MS = 1000; // Requests closer together are merged
+static constexpr uint32_t LINK_MIN_PING_GAP_MS = 100;         // Early pings after a fader release
+
+//================================
+// STATE
+//================================
+
+static ConsoleLinkStats linkStats = {};
+
+static int32_t wingId = -1;                 // Low 24 bits of the MAC, read on the first ping
+static uint32_t nextPingMs = 0;
+static uint32_t lastPingMs = 0;
+static uint32_t lastPongMs = 0;
+static bool pongSeen = false;
+static uint32_t lastHeardMs = 0;            // Last pong or heartbeat
+static bool heard = false;
+static bool networkWasReady = false;
+
+static bool resyncSent = false;
+static bool resyncPending = false;
+static uint8_t pendingResyncReason = RESYNC_BOOT;
+static uint32_t lastResyncMs = 0;
+
+static int32_t lastUpdateSeq[CONSOLE_STREAM_COUNT] = {};
+static bool haveUpdateSeq[CONSOLE_STREAM_COUNT] = {};
+static int32_t advertisedSeq[CONSOLE_STREAM_COUNT] = {};   // From the previous heartbeat
+static bool haveAdvertised = false;
+
+//================================
+// PING / PONG
+//================================
+
+static int32_t getWingId() {
+  if (wingId < 0) {
+    uint8_t mac[6];
+    Ethernet.macAddress(mac);
+    wingId = ((int32_t)mac[3] << 16) | ((int32_t)mac[4] << 8) | mac[5];
+  }
+  return wingId;
+}
+
+static void sendPing() {
+  char cmd[80];
+  linkStats.lastSeq++;
+  snprintf(cmd, sizeof(cmd), "SetGlobalVariable \"EvoPing\" \"%lu,%lu,%ld\"",
+           (unsigned long)linkStats.lastSeq, (unsigned long)(millis() & LINK_TIMESTAMP_MASK), (long)getWingId());
+  sendOscMessage("/cmd", ",s", cmd);
+  linkStats.pingsSent++;
+  lastPingMs = millis();
+}
+
+void consoleLinkPingSoon() {
+  const uint32_t soon = max(millis(), lastPingMs + LINK_MIN_PING_GAP_MS);
+  if ((int32_t)(nextPingMs - soon) > 0) {
+    nextPingMs = soon;
+  }
+}
+
+uint32_t consoleLinkNextPingSeq() {
+  return linkStats.lastSeq + 1;
+}
+
+bool consoleLinkConfirms(uint32_t seq) {
+  return pongSeen && linkStats.lastPongSeq >= seq;
+}
+
+bool consoleLinkHasPongs() {
+  return pongSeen && linkStats.state != LINK_LOST;
+}
+
+void handleConsolePong(int32_t seq, int32_t sentMs, int32_t id) {
+  // Another wing on the same console pinged through the shared variable
+  if (id != getWingId()) {
+    linkStats.otherWingPongs++;
+    return;
+  }
+
+  const uint32_t now = millis();
+  const uint32_t rtt = (now - (uint32_t)sentMs) & LINK_TIMESTAMP_MASK;
+
+  // Pongs for pings we never sent (previous boot) or already answered
+  if ((uint32_t)seq > linkStats.lastSeq || rtt > LINK_MAX_RTT_MS ||
+      (pongSeen && (uint32_t)seq <= linkStats.lastPongSeq)) {
+    linkStats.latePongs++;
+    return;
+  }
+
+  // RFC 6298 style estimator: the first sample seeds both values
+  if (!pongSeen) {
+    linkStats.srttMs = rtt;
+    linkStats.jitterMs = rtt / 2;
+  } else {
+    const uint32_t deviation = (rtt > linkStats.srttMs) ? rtt - linkStats.srttMs : linkStats.srttMs - rtt;
+    linkStats.jitterMs = (linkStats.jitterMs * 3 + deviation) / 4;
+    linkStats.srttMs = (linkStats.srttMs * 7 + rtt) / 8;
+  }
+
+  linkStats.lastRttMs = rtt;
+  linkStats.lastPongSeq = seq;
+  linkStats.pongsReceived++;
+  lastPongMs = now;
+  pongSeen = true;
+  lastHeardMs = now;
+  heard = true;
+}
+
+//================================
+// LINK STATE
+//================================
+
+static uint8_t evaluateState(uint32_t now) {
+  if (!heard) return LINK_UNKNOWN;
+
+  const uint32_t age = now - lastHeardMs;
+  if (age > LINK_LOST_AGE_MS) return LINK_LOST;
+  if (age > LINK_DEGRADED_AGE_MS || linkStats.srttMs > LINK_SLOW_RTT_MS || linkStats.jitterMs > LINK_HIGH_JITTER_MS) {
+    return LINK_DEGRADED;
+  }
+  return LINK_GOOD;
+}
+
+//================================
+// RESYNC
+//================================
+
+static void sendResync(uint8_t reason) {
+  // The plugin polls forceReload every tick and answers with a full snapshot on the next one
+  sendOscMessage("/cmd", ",s", "SetGlobalVariable \"forceReload\" \"true\"");
+  linkStats.resyncRequests++;
+  linkStats.resyncByReason[reason]++;
+  lastResyncMs = millis();
+  resyncSent = true;
+  resyncPending = false;
+  debugPrintf("[LINK] Resync requested (%s)\n", consoleResyncReasonName(reason));
+}
+
+void requestConsoleResync(uint8_t reason) {
+  if (reason >= RESYNC_REASON_COUNT) return;
+
+  if (resyncSent && millis() - lastResyncMs < LINK_RESYNC_MIN_INTERVAL_MS) {
+    resyncPending = true;
+    pendingResyncReason = reason;
+    return;
+  }
+  sendResync(reason);
+}
+
+void noteConsoleUpdateSeq(uint8_t stream, int32_t seq) {
+  if (stream >= CONSOLE_STREAM_COUNT) return;
+
+  // Color bundles are coalesced in our own queue, so only exec numbering shows real loss.
+  // Every bundle is a full snapshot: a gap is counted, the bundle itself repairs the state.
+  if (stream == CONSOLE_STREAM_EXEC && haveUpdateSeq[stream] && seq - lastUpdateSeq[stream] > 1) {
+    linkStats.seqGaps++;
+  }
+  lastUpdateSeq[stream] = seq;
+  haveUpdateSeq[stream] = true;
+}
+
+// The plugin only sends bundles when something changes, so a lost final bundle would leave us
+// stale until the next change. Each heartbeat carries the latest sequence of each stream; by the
+// following heartbeat we must have handled at least that much.
+void handleConsoleHeartbeat(int32_t execSeq, int32_t colorSeq) {
+  lastHeardMs = millis();
+  heard = true;
+
+  const int32_t current[CONSOLE_STREAM_COUNT] = {execSeq, colorSeq};
+  bool missed = false;
+
+  // Numbers going backwards mean the plugin restarted, and it sends a fresh snapshot anyway
+  bool restarted = false;
+  for (uint8_t s = 0; s < CONSOLE_STREAM_COUNT; s++) {
+    if (current[s] < advertisedSeq[s]) restarted = true;
+  }
+
+  if (haveAdvertised && !restarted) {
+    for (uint8_t s = 0; s < CONSOLE_STREAM_COUNT; s++) {
+      if (advertisedSeq[s] > 0 && (!haveUpdateSeq[s] || lastUpdateSeq[s] - advertisedSeq[s] < 0)) {
+        missed = true;
+      }
+    }
+  }
+
+  for (uint8_t s = 0; s < CONSOLE_STREAM_COUNT; s++) {
+    advertisedSeq[s] = current[s];
+  }
+  haveAdvertised = true;
+
+  if (missed) {
+    linkStats.missedUpdates++;
+    requestConsoleResync(RESYNC_SEQ_GAP);
+  }
+}
+
+void consoleLinkLoop() {
+  const uint32_t now = millis();
+
+  const bool ready = networkReady();
+  if (ready && !networkWasReady) {
+    requestConsoleResync(resyncSent ? RESYNC_LINK_UP : RESYNC_BOOT);
+  }
+  networkWasReady = ready;
+  if (!networkWasReady) return;
+
+  if (resyncPending && now - lastResyncMs >= LINK_RESYNC_MIN_INTERVAL_MS) {
+    sendResync(pendingResyncReason);
+  }
+
+  if ((int32_t)(now - nextPingMs) >= 0) {
+    nextPingMs = now + LINK_IDLE_PING_INTERVAL_MS;
+    sendPing();
+  }
+
+  if (pongSeen) {
+    linkStats.lastPongAgeMs = now - lastPongMs;
+  }
+
+  const uint8_t state = evaluateState(now);
+  if (state == linkStats.state) return;
+
+  const uint8_t previous = linkStats.state;
+  linkStats.state = state;
+  debugPrintf("[LINK] Console link %s -> %s (rtt %lums, jitter %lums)\n",
+              consoleLinkStateName(previous), consoleLinkStateName(state),
+              (unsigned long)linkStats.srttMs, (unsigned long)linkStats.jitterMs);
+
+  if (state == LINK_LOST) {
+    linkStats.lostCount++;
+  } else if (previous == LINK_LOST) {
+    // Setpoints held while we were cut off may be stale
+    requestConsoleResync(RESYNC_LINK_UP);
+  }
+
+  displayConsoleLinkStatus();
+}
+
+bool consoleLinkAllowsMotion() {
+  return linkStats.state != LINK_LOST;
+}
+
+void displayConsoleLinkStatus() {
+  char line[22];
+  if (linkStats.state == LINK_UNKNOWN) {
+    snprintf(line, sizeof(line), "Link: --");
+  } else if (linkStats.state == LINK_LOST) {
+    snprintf(line, sizeof(line), "Link: LOST");
+  } else {
+    snprintf(line, sizeof(line), "Link: %s %lums", consoleLinkStateName(linkStats.state), (unsigned long)linkStats.srttMs);
+  }
+  display.showStatus(line);
+  display.display();
+}
+
+const ConsoleLinkStats& getConsoleLinkStats() {
+  return linkStats;
+}
+
+const char* consoleLinkStateName(uint8_t state) {
+  switch (state) {
+    case LINK_UNKNOWN: return "unknown";
+    case LINK_GOOD: return "good";
+    case LINK_DEGRADED: return "degraded";
+    case LINK_LOST: return "lost";
+    default: return "?";
+  }
+}
+
+const char* consoleResyncReasonName(uint8_t reason) {
+  switch (reason) {
+    case RESYNC_BOOT: return "boot";
+    case RESYNC_LINK_UP: return "link up";
+    case RESYNC_SEQ_GAP: return "missed update";
+    case RESYNC_FAILOVER: return "failover";
+    case RESYNC_FADER_ECHO: return "fader echo";
+    default: return "?";
+  }
+}
@@ -8,6 +8,8 @@
 #include "NetworkOSC.h"
 #include "NeoPixelControl.h"
 #include "KeyLedControl.h"
+#include "ExecutorStatus.h"
+#include "SacnReceiver.h"
 
 //================================
 // CALIBRATION FUNCTIONS
@@ -69,6 +71,7 @@ void loadConfig() {
     Fconfig.serialDebug = Fconfig.serialDebug ? true : false;
     Fconfig.sendKeystrokes = Fconfig.sendKeystrokes ? true : false;
     Fconfig.useLevelPixels = Fconfig.useLevelPixels ? true : false;
+    Fconfig.ditherDimColors = Fconfig.ditherDimColors ? true : false;
     // Clamp slow/fast zones to sane OSC range and ordering
     if (Fconfig.slowZone > 100) Fconfig.slowZone = 100;
     if (Fconfig.fastZone > 100) Fconfig.fastZone = 100;
@@ -109,6 +112,20 @@ void saveNetworkConfig() {
  
   // DHCP flag
   EEPROM.write(addr++, netConfig.useDHCP ? 1 : 0);
+
+  // Multicast group (own signature so configs saved before it existed still load)
+  EEPROM.write(addr++, NETCFG_MCAST_SIGNATURE);
+  for (int i = 0; i < 4; i++) EEPROM.write(addr++, netConfig.multicastIP[i]);
+  EEPROM.write(addr++, netConfig.useMulticast ? 1 : 0);
+
+  // Backup console
+  EEPROM.write(addr++, NETCFG_BACKUP_SIGNATURE);
+  for (int i = 0; i < 4; i++) EEPROM.write(addr++, netConfig.backupIP[i]);
+  EEPROM.write(addr++, netConfig.useBackup ? 1 : 0);
+
+  // OSC transport
+  EEPROM.write(addr++, NETCFG_TRANSPORT_SIGNATURE);
+  EEPROM.write(addr++, netConfig.oscTransport);
  
   bool configChanged = false;
   int checkAddr = NETCFG_EEPROM_ADDR + 1; // Skip signature
@@ -162,7 +179,25 @@ bool loadNetworkConfig() {
   EEPROM.get(addr, netConfig.sendPort);    addr += sizeof(uint16_t);
  
   netConfig.useDHCP = EEPROM.read(addr++) ? true : false;
- 
+
+  // Appended blocks, each only valid if every block before it was written too
+  bool extended = (EEPROM.read(addr++) == NETCFG_MCAST_SIGNATURE);
+  if (extended) {
+    for (int i = 0; i < 4; i++) netConfig.multicastIP[i] = EEPROM.read(addr++);
+    netConfig.useMulticast = EEPROM.read(addr++) ? true : false;
+  }
+
+  extended = extended && (EEPROM.read(addr++) == NETCFG_BACKUP_SIGNATURE);
+  if (extended) {
+    for (int i = 0; i < 4; i++) netConfig.backupIP[i] = EEPROM.read(addr++);
+    netConfig.useBackup = EEPROM.read(addr++) ? true : false;
+  }
+
+  extended = extended && (EEPROM.read(addr++) == NETCFG_TRANSPORT_SIGNATURE);
+  if (extended) {
+    uint8_t transport = EEPROM.read(addr++);
+    netConfig.oscTransport = (transport == OSC_TRANSPORT_TCP) ? OSC_TRANSPORT_TCP : OSC_TRANSPORT_UDP;
+  }
 
   debugPrint("Network config loaded from EEPROM.");
   return true;
@@ -284,6 +319,57 @@ bool loadExecConfig() {
   return true;
 }
 
+void saveKeyLedMap() {
+  EEPROM.write(EEPROM_KEYMAP_SIGNATURE_ADDR, KEYMAP_EEPROM_SIGNATURE);
+  EEPROM.put(EEPROM_KEYMAP_DATA_ADDR, keyLedMap);
+  debugPrint("Key LED map saved to EEPROM.");
+}
+
+bool loadKeyLedMap() {
+  if (EEPROM.read(EEPROM_KEYMAP_SIGNATURE_ADDR) != KEYMAP_EEPROM_SIGNATURE) {
+    debugPrint("No key LED map in EEPROM, using defaults.");
+    return false;
+  }
+
+  EEPROM.get(EEPROM_KEYMAP_DATA_ADDR, keyLedMap);
+
+  // Entries that do not fit the strip are dropped instead of wrapping round
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+    if (!isValidKeyLedMapEntry(keyLedMap.keys[i])) {
+      keyLedMap.keys[i].count = 0;
+    }
+    keyLedMap.keys[i].reserved = 0;
+  }
+
+  applyKeyLedMap();
+  debugPrint("Key LED map loaded from EEPROM.");
+  return true;
+}
+
+void saveSacnConfig() {
+  EEPROM.write(EEPROM_SACN_SIGNATURE_ADDR, SACN_EEPROM_SIGNATURE);
+  EEPROM.put(EEPROM_SACN_DATA_ADDR, sacnConfig);
+  debugPrint("sACN config saved to EEPROM.");
+}
+
+bool loadSacnConfig() {
+  if (EEPROM.read(EEPROM_SACN_SIGNATURE_ADDR) != SACN_EEPROM_SIGNATURE) {
+    debugPrint("No sACN config in EEPROM, using defaults.");
+    return false;
+  }
+
+  SacnConfig stored;
+  EEPROM.get(EEPROM_SACN_DATA_ADDR, stored);
+  if (!isValidSacnConfig(stored)) {
+    debugPrint("sACN config in EEPROM is invalid, using defaults.");
+    return false;
+  }
+
+  sacnConfig = stored;
+  debugPrint("sACN config loaded from EEPROM.");
+  return true;
+}
+
 //================================
 // COMBINED CONFIGURATION FUNCTIONS
 //================================
@@ -294,6 +380,8 @@ void loadAllConfig() {
   loadNetworkConfig();   // Load network configuration
   loadTouchConfig();     // Load touch sensor configuration
   loadExecConfig();      // Load executor LED configuration
+  loadKeyLedMap();       // Load executor key LED map
+  loadSacnConfig();      // Load sACN input settings
   loadCalibration();
 }
 
@@ -303,6 +391,8 @@ void saveAllConfig() {
   saveNetworkConfig();   // Save network configuration
   saveTouchConfig();     // Save touch sensor configuration
   saveExecConfig();      // Save executor LED configuration
+  saveKeyLedMap();       // Save executor key LED map
+  saveSacnConfig();      // Save sACN input settings
   saveCalibration();
 }
 
@@ -325,6 +415,7 @@ void resetToDefaults() {
   Fconfig.serialDebug = false;
   Fconfig.sendKeystrokes = false;
   Fconfig.useLevelPixels = false;
+  Fconfig.ditherDimColors = false;
 
   // Reset executor LED settings
   execConfig.baseBrightness = EXECUTOR_BASE_BRIGHTNESS;
@@ -335,6 +426,18 @@ void resetToDefaults() {
   execConfig.staticBlue = 255;
   execConfig.reserved[0] = 0;
   execConfig.reserved[1] = 0;
+  keyLedMap = DEFAULT_KEY_LED_MAP;
+  applyKeyLedMap();
+
+  // Reset sACN input settings
+  sacnConfig.enabled = false;
+  sacnConfig.wingPriority = SACN_DEFAULT_WING_PRIORITY;
+  sacnConfig.universe = SACN_DEFAULT_UNIVERSE;
+  sacnConfig.faderAddress = SACN_DEFAULT_FADER_ADDRESS;
+  sacnConfig.keyAddress = SACN_DEFAULT_KEY_ADDRESS;
+  sacnConfig.reserved[0] = 0;
+  sacnConfig.reserved[1] = 0;
+  setupSacn();
 
   
   // Reset network settings to defaults
@@ -345,6 +448,11 @@ void resetToDefaults() {
   netConfig.sendToIP = IPAddress(192, 168, 0, 10);
   netConfig.receivePort = 8000;
   netConfig.sendPort = 9000;
+  netConfig.multicastIP = IPAddress(239, 1, 1, 1);
+  netConfig.useMulticast = false;
+  netConfig.backupIP = IPAddress(192, 168, 0, 11);
+  netConfig.useBackup = false;
+  netConfig.oscTransport = OSC_TRANSPORT_UDP;
 
   
   // Reset touch settings
@@ -379,6 +487,11 @@ void resetNetworkDefaults() {
   netConfig.sendToIP = IPAddress(192, 168, 0, 100);
   netConfig.receivePort = 8000;
   netConfig.sendPort = 9000;
+  netConfig.multicastIP = IPAddress(239, 1, 1, 1);
+  netConfig.useMulticast = false;
+  netConfig.backupIP = IPAddress(192, 168, 0, 11);
+  netConfig.useBackup = false;
+  netConfig.oscTransport = OSC_TRANSPORT_UDP;
   
   // Save to EEPROM
   saveNetworkConfig();
@@ -513,6 +626,34 @@ void dumpEepromConfig() {
                EEPROM.read(EEPROM_EXEC_SIGNATURE_ADDR), EXECCFG_EEPROM_SIGNATURE);
   }
 
+  // Check key LED map
+  debugPrint("\n--- Key LED Map ---");
+  if (EEPROM.read(EEPROM_KEYMAP_SIGNATURE_ADDR) == KEYMAP_EEPROM_SIGNATURE) {
+    KeyLedMap storedMap;
+    EEPROM.get(EEPROM_KEYMAP_DATA_ADDR, storedMap);
+    for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+      debugPrintf("Key %d: start %d, %d pixels\n", EXECUTOR_IDS[i], storedMap.keys[i].start, storedMap.keys[i].count);
+    }
+  } else {
+    debugPrintf("Key LED map not found (signature=0x%02X, expected=0x%02X)\n",
+               EEPROM.read(EEPROM_KEYMAP_SIGNATURE_ADDR), KEYMAP_EEPROM_SIGNATURE);
+  }
+
+  // Check sACN config
+  debugPrint("\n--- sACN Input ---");
+  if (EEPROM.read(EEPROM_SACN_SIGNATURE_ADDR) == SACN_EEPROM_SIGNATURE) {
+    SacnConfig storedSacn;
+    EEPROM.get(EEPROM_SACN_DATA_ADDR, storedSacn);
+    debugPrintf("Enabled: %s\n", storedSacn.enabled ? "Yes" : "No");
+    debugPrintf("Universe: %u\n", storedSacn.universe);
+    debugPrintf("Fader Address: %u\n", storedSacn.faderAddress);
+    debugPrintf("Key Address: %u\n", storedSacn.keyAddress);
+    debugPrintf("Wing Priority: %u\n", storedSacn.wingPriority);
+  } else {
+    debugPrintf("sACN config not found (signature=0x%02X, expected=0x%02X)\n",
+               EEPROM.read(EEPROM_SACN_SIGNATURE_ADDR), SACN_EEPROM_SIGNATURE);
+  }
+
   
   debugPrint("\n===== END OF EEPROM DUMP =====\n");
 
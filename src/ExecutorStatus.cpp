@@ -34,6 +34,10 @@ bool setExecutorStateByIndex(int index, uint8_t status) {
   bool changed = executorStatus[index] != clamped;
   executorStatus[index] = clamped;
 
+  if (changed) {
+    markKeyLedDirty(index);
+  }
+
   if (execDebug){
     debugPrintf("Exec %d state: %d", EXECUTOR_IDS[index], status);
   }
@@ -63,7 +67,7 @@ bool setExecutorColorByIndex(int index, uint8_t r, uint8_t g, uint8_t b) {
   executorColors[index][2] = bb;
 
   if (changed) {
-    markKeyLedsDirty();
+    markKeyLedDirty(index);
   }
 
   return changed;
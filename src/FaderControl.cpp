@@ -5,6 +5,8 @@
 #include "WebServer.h"
 #include "Utils.h"
 #include "NeoPixelControl.h"
+#include "ConsoleLink.h"
+#include "LedAnimation.h"
 
 
 bool faderDebug = false;
@@ -12,6 +14,15 @@ bool FaderRetryPending = false;
 unsigned long FaderRetryTime = 0;
 static bool FaderMoveActive = false;
 
+// Echo suppression after a touch release
+static constexpr unsigned long FADER_ECHO_HOLDOFF_MS = 500;   // Without ping confirmations (older plugin, link lost)
+static constexpr unsigned long FADER_ECHO_MAX_WAIT_MS = 3000; // Give up waiting for a confirmation
+static bool faderWasTouched[NUM_FADERS] = {false};
+static uint32_t faderEchoesIgnored = 0;
+
+static void handleFaderRelease(Fader& f);
+static void resolveHeldFaderEcho(Fader& f);
+
 //================================
 // MOTOR CONTROL
 //================================
@@ -155,6 +166,9 @@ void moveAllFadersToSetpoints() {
     
     // Yield to prevent overwhelming the system
     yield();
+
+    // Keep LED frames and effects running while the motors move
+    renderLedFrame();
     
     // Add timeout protection to prevent infinite loops
 
@@ -162,8 +176,7 @@ void moveAllFadersToSetpoints() {
       // Stop all motors and flash red on faders that didn't reach target
       bool failed[NUM_FADERS] = {false};
       bool retryNeeded = false;
-      uint8_t origColors[NUM_FADERS][3] = {{0}};
-      uint8_t scaledRed = (uint8_t)((255UL * Fconfig.touchedBrightness) / 255UL);
+      uint16_t failedMask = 0;
 
       for (int i = 0; i < NUM_FADERS; i++) {
         Fader& f = faders[i];
@@ -177,31 +190,13 @@ void moveAllFadersToSetpoints() {
         int difference = f.setpoint - currentOscValue;
         if (abs(difference) > Fconfig.targetTolerance && !f.touched) {
           failed[i] = true;
-          origColors[i][0] = f.red;
-          origColors[i][1] = f.green;
-          origColors[i][2] = f.blue;
+          failedMask |= (1U << i);
         }
       }
 
-      // Flash all failed faders together (full strip red) without using
-      for (int flash = 0; flash < 3; flash++) {
-        for (int i = 0; i < NUM_FADERS; i++) {
-          if (!failed[i]) continue;
-          for (int j = 0; j < PIXELS_PER_FADER; j++) {
-            pixels.setPixelColor(i * PIXELS_PER_FADER + j, pixels.Color(scaledRed, 0, 0));
-          }
-        }
-        pixels.show();
-        delay(150);
-
-        for (int i = 0; i < NUM_FADERS; i++) {
-          if (!failed[i]) continue;
-          for (int j = 0; j < PIXELS_PER_FADER; j++) {
-            pixels.setPixelColor(i * PIXELS_PER_FADER + j, pixels.Color(origColors[i][0], origColors[i][1], origColors[i][2]));
-          }
-        }
-        pixels.show();
-        delay(50);
+      // Flash all failed faders together (full strip red), plays from the next LED frames
+      if (failedMask) {
+        startFaderFlash(failedMask, pixels.Color(Fconfig.touchedBrightness, 0, 0), 3, 150, 50);
       }
       
       // Track failures and disable motors that repeatedly time out
@@ -281,9 +276,15 @@ void handleFaders() {
   for (int i = 0; i < NUM_FADERS; i++) {
     Fader& f = faders[i];
 
-    if (!f.touched){    
+    if (!f.touched){
+      if (faderWasTouched[i]) {
+        faderWasTouched[i] = false;
+        handleFaderRelease(f);
+      }
+      resolveHeldFaderEcho(f);
       continue;
     }
+    faderWasTouched[i] = true;
 
     // Read current position and get OSC value in one call
     int currentOscValue = readFadertoOSC(f);
@@ -315,6 +316,71 @@ void handleFaders() {
 
 
 
+// The last move may have been held back by send tolerance or rate limiting: send where the
+// fader really stopped, then ping so the console confirms it as soon as possible
+static void handleFaderRelease(Fader& f) {
+  int currentOscValue = readFadertoOSC(f);
+  if (currentOscValue != f.lastSentOscValue) {
+    sendFaderOsc(f, currentOscValue, true);
+    f.lastReportedValue = currentOscValue;
+    f.setpoint = currentOscValue;
+  }
+  consoleLinkPingSoon();
+}
+
+// Console values are held back until the console has confirmed our last write
+static bool echoWindowOpen(const Fader& f) {
+  const unsigned long sinceRelease = millis() - f.releaseTime;
+  if (consoleLinkHasPongs()) {
+    return !consoleLinkConfirms(f.echoConfirmSeq) && sinceRelease < FADER_ECHO_MAX_WAIT_MS;
+  }
+  return sinceRelease < FADER_ECHO_HOLDOFF_MS;
+}
+
+// True if a console value for this fader was produced before the console saw our last write.
+// Last writer wins: once the console confirms our write, its values are taken again.
+bool isStaleFaderEcho(Fader& f, int page, int consoleValue) {
+  if (f.lastSentOscValue > 100 || page != f.echoPage || f.touched) {
+    return false;  // Never written, or not the page we wrote on (touched faders ignore input anyway)
+  }
+  if (abs(consoleValue - f.lastSentOscValue) <= Fconfig.targetTolerance) {
+    f.heldEchoValue = -1;
+    return false;  // Agrees with us
+  }
+
+  const bool stale = echoWindowOpen(f);
+  if (!stale) {
+    f.heldEchoValue = -1;
+  } else {
+    // Could also be a real change made on the console meanwhile: resolved when the window closes
+    f.heldEchoValue = consoleValue;
+    faderEchoesIgnored++;
+    if (faderDebug) {
+      debugPrintf("Fader %d: ignoring stale console value %d (sent %d)\n", f.oscID, consoleValue, f.lastSentOscValue);
+    }
+  }
+  return stale;
+}
+
+// A value held back while the window was open is either our own echo or a console change
+// nobody will send again. Only a fresh snapshot tells which, so ask for one.
+static void resolveHeldFaderEcho(Fader& f) {
+  if (f.heldEchoValue < 0 || echoWindowOpen(f)) return;
+
+  const bool samePage = (f.echoPage == currentOSCPage);
+  if (faderDebug) {
+    debugPrintf("Fader %d: held console value %d after window (sent %d)\n", f.oscID, f.heldEchoValue, f.lastSentOscValue);
+  }
+  f.heldEchoValue = -1;
+  if (samePage) {
+    requestConsoleResync(RESYNC_FADER_ECHO);
+  }
+}
+
+uint32_t getFaderEchoesIgnored() {
+  return faderEchoesIgnored;
+}
+
 // Read fader analog pin and return OSC value (0-100) using fader's calibrated range, with clamping at both ends
 int readFadertoOSC(Fader& f) {
   int analogValue = analogRead(f.analogPin);
@@ -369,6 +435,9 @@ void sendFaderOsc(Fader& f, int value, bool force) {
     
     f.lastOscSendTime = now;
     f.lastSentOscValue = value;
+    f.echoPage = currentOSCPage;
+    f.echoConfirmSeq = consoleLinkNextPingSeq();
+    f.heldEchoValue = -1;   // Our newer write wins over anything held back
   }
 }
 
@@ -385,7 +454,8 @@ int getFaderIndexFromID(int id) {
 
 
 void checkFaderRetry() {
-  if (FaderRetryPending && millis() >= FaderRetryTime) {
+  // Stay pending while the console link is lost, the retry runs once it is back
+  if (FaderRetryPending && millis() >= FaderRetryTime && consoleLinkAllowsMotion()) {
     FaderRetryPending = false;
     if (faderDebug) {
       debugPrint("Retrying fader movement...");
@@ -3,33 +3,50 @@
 #include "KeyLedControl.h"
 #include "ExecutorStatus.h"
 #include "Utils.h"
-#include <Adafruit_NeoPixel.h>
-
-// Separate strip for the executor keys
-Adafruit_NeoPixel keyPixels(EXECUTOR_LED_COUNT, EXECUTOR_LED_PIN, NEO_RGB + NEO_KHZ800);
-
-static bool keyLedsDirty = false;
-
-// Physical strip order for the exec keys (serpentine):
-// 401-410, 310-301, 201-210, 110-101
-// Map to absolute start pixel indices so gaps can be ignored by
-// editing the start values directly (EXECUTOR_LED_COUNT must be total including gap pixels).
-static const uint16_t EXEC_LED_START[NUM_EXECUTORS_TRACKED] = {
-  // 101-110 (bottom row, reversed)
-  78, 76, 74, 72, 70, 68, 66, 64, 62, 60,
-  // 201-210
-  40, 42, 44, 46, 48, 50, 52, 54, 56, 58,
-  // 301-310 (reversed)
-  38, 36, 34, 32, 32, 32, 32, 32, 32, 32,
-  // 401-410 (top row)
-  0, 3, 6, 9, 13, 18, 21, 24, 27, 30
+#include "ConsoleLink.h"
+#include "LedOutput.h"
+#include "ColorMath.h"
+#include "SacnReceiver.h"
+
+// Key strip, sent in the same transfer as the fader strip. Covers the whole output so
+// the key LED map can place keys anywhere on it.
+LedStrip keyPixels(ledEngine, LED_OUTPUT_KEYS, LED_STRIP_LENGTH);
+
+// One bit per key (EXECUTOR_IDS order): only marked keys are rebuilt on the next LED frame
+static_assert(NUM_EXECUTORS_TRACKED <= 64, "Key dirty mask holds 64 keys");
+static constexpr uint64_t ALL_KEYS_MASK = (NUM_EXECUTORS_TRACKED == 64) ? ~0ULL : ((1ULL << NUM_EXECUTORS_TRACKED) - 1);
+static uint64_t keyDirtyMask = 0;
+static uint32_t renderedKeyColor[NUM_EXECUTORS_TRACKED];   // Last color written per key
+static uint64_t ditheredKeyMask = 0;   // Keys whose dim color is dithered: redrawn every frame
+static uint8_t keyDitherFrame = 0;
+
+// Provisional key states shown until the console reconciles them
+static constexpr uint32_t KEY_PREDICTION_GRACE_MS = 50;      // After the console confirms, wait for its bundle
+static constexpr uint32_t KEY_PREDICTION_HOLDOFF_MS = 250;   // Without ping confirmations
+static constexpr uint32_t KEY_PREDICTION_MAX_MS = 1000;
+
+struct KeyPrediction {
+  bool     active;
+  uint8_t  status;         // Predicted executorStatus value
+  uint32_t confirmSeq;     // Console link ping sent after the key press
+  uint32_t startMs;
+  uint32_t confirmedMs;    // When the ping was first seen answered, 0 until then
 };
 
-static uint32_t buildExecColor(int execIndex, uint8_t brightness) {
-  if (brightness == 0) {
-    return keyPixels.Color(0, 0, 0);
-  }
+static KeyPrediction keyPredictions[NUM_EXECUTORS_TRACKED];
+static uint64_t predictionMask = 0;   // Keys with an active prediction
+static KeyLedPredictionStats predictionStats = {};
 
+// keyLedMap compiled into a flat pixel list: key i owns keyPixelIndex[keyPixelFirst[i]] up to
+// keyPixelIndex[keyPixelFirst[i + 1]], so drawing a key is a straight indexed write.
+// A pixel mapped to several keys belongs to the last of them only (the one a full redraw
+// in key order used to leave showing), so redrawing one key never paints over another.
+static uint16_t keyPixelIndex[NUM_EXECUTORS_TRACKED * KEY_LED_MAX_PIXELS];
+static uint16_t keyPixelFirst[NUM_EXECUTORS_TRACKED + 1];
+
+// Key color in 8.8 fixed point: the high bytes are the plain 8-bit color, the low bytes
+// what it drops at low brightness (EXECUTOR_BASE_BRIGHTNESS) and get dithered
+static void buildExecColor16(int execIndex, uint8_t brightness, uint16_t out[3]) {
   if (!execConfig.useStaticColor) {
     uint8_t baseR = executorColors[execIndex][0];
     uint8_t baseG = executorColors[execIndex][1];
@@ -37,61 +54,218 @@ static uint32_t buildExecColor(int execIndex, uint8_t brightness) {
 
     // If no color received yet, default to white scaled by brightness
     if (baseR == 0 && baseG == 0 && baseB == 0) {
-      return keyPixels.Color(brightness, brightness, brightness);
+      out[0] = out[1] = out[2] = (uint16_t)brightness << 8;
+      return;
     }
 
-    uint8_t r = (uint16_t)baseR * brightness / 255;
-    uint8_t g = (uint16_t)baseG * brightness / 255;
-    uint8_t b = (uint16_t)baseB * brightness / 255;
-    return keyPixels.Color(r, g, b);
+    scaleColor16(baseR, baseG, baseB, brightness, out);
+    return;
   }
 
-  uint8_t r = (uint16_t)execConfig.staticRed * brightness / 255;
-  uint8_t g = (uint16_t)execConfig.staticGreen * brightness / 255;
-  uint8_t b = (uint16_t)execConfig.staticBlue * brightness / 255;
-  return keyPixels.Color(r, g, b);
+  scaleColor16(execConfig.staticRed, execConfig.staticGreen, execConfig.staticBlue, brightness, out);
 }
 
-static void fillExecutorPixels(int execIndex, uint8_t brightness) {
+// Returns true if the key's pixels changed
+static bool fillExecutorPixels(int execIndex, uint8_t brightness) {
   if (execIndex < 0 || execIndex >= NUM_EXECUTORS_TRACKED) {
-    return;
+    return false;
   }
 
-  uint32_t color = buildExecColor(execIndex, brightness);
-  int startPixel = EXEC_LED_START[execIndex];
-  if (startPixel < 0 || startPixel + EXECUTOR_PIXELS_PER_KEY > EXECUTOR_LED_COUNT) {
-    return;
+  uint16_t channels[3];
+  buildExecColor16(execIndex, brightness, channels);
+  uint32_t color = keyPixels.Color(channels[0] >> 8, channels[1] >> 8, channels[2] >> 8);
+  const uint64_t bit = 1ULL << execIndex;
+
+  // sACN input replaces or merges the color; its values are already 8-bit
+  const bool mapped = keyPixelFirst[execIndex] != keyPixelFirst[execIndex + 1];
+  if (!mergeSacnKeyColor(execIndex, color) && mapped && Fconfig.ditherDimColors && needsDither(channels)) {
+    for (uint16_t p = keyPixelFirst[execIndex]; p < keyPixelFirst[execIndex + 1]; ++p) {
+      keyPixels.setPixelColor(keyPixelIndex[p], ditherColor16(channels, keyDitherFrame + execIndex * 3 + p * 5));
+    }
+    ditheredKeyMask |= bit;
+    renderedKeyColor[execIndex] = 0xFFFFFFFF;   // Redrawn once it stops dithering
+    return true;
+  }
+  ditheredKeyMask &= ~bit;
+
+  if (color == renderedKeyColor[execIndex]) {
+    return false;
   }
 
-  for (int i = 0; i < EXECUTOR_PIXELS_PER_KEY; ++i) {
-    keyPixels.setPixelColor(startPixel + i, color);
+  for (uint16_t p = keyPixelFirst[execIndex]; p < keyPixelFirst[execIndex + 1]; ++p) {
+    keyPixels.setPixelColor(keyPixelIndex[p], color);
   }
+  renderedKeyColor[execIndex] = color;
+  return true;
+}
+
+bool keyLedsDithering() {
+  return ditheredKeyMask != 0;
+}
+
+bool isValidKeyLedMapEntry(const KeyLedMapEntry& entry) {
+  return entry.count <= KEY_LED_MAX_PIXELS && entry.start + entry.count <= LED_STRIP_LENGTH;
+}
+
+void applyKeyLedMap() {
+  static_assert(NUM_EXECUTORS_TRACKED < 255, "Pixel owner is a uint8_t key index");
+  static uint8_t pixelOwner[LED_STRIP_LENGTH];
+  memset(pixelOwner, 0xFF, sizeof(pixelOwner));
+
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; ++i) {
+    const KeyLedMapEntry& entry = keyLedMap.keys[i];
+    if (!isValidKeyLedMapEntry(entry)) {
+      debugPrintf("Key LED map: key %d (%d+%d) does not fit the strip, left dark\n",
+                  EXECUTOR_IDS[i], entry.start, entry.count);
+      continue;
+    }
+    for (uint8_t p = 0; p < entry.count; ++p) {
+      pixelOwner[entry.start + p] = i;
+    }
+  }
+
+  uint16_t n = 0;
+  uint16_t shared = 0;
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; ++i) {
+    keyPixelFirst[i] = n;
+    const KeyLedMapEntry& entry = keyLedMap.keys[i];
+    if (!isValidKeyLedMapEntry(entry)) {
+      continue;
+    }
+    for (uint8_t p = 0; p < entry.count; ++p) {
+      if (pixelOwner[entry.start + p] == i) {
+        keyPixelIndex[n++] = entry.start + p;
+      } else {
+        shared++;
+      }
+    }
+  }
+  keyPixelFirst[NUM_EXECUTORS_TRACKED] = n;
+  if (shared > 0) {
+    debugPrintf("Key LED map: %d shared pixel(s) shown by the later key only\n", shared);
+  }
+
+  // Pixels a key gave up must go dark, then every key is drawn again
+  keyPixels.clear();
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; ++i) {
+    renderedKeyColor[i] = 0;
+  }
+  keyDirtyMask = ALL_KEYS_MASK;
 }
 
 void setupKeyLeds() {
   keyPixels.begin();
-  keyPixels.clear();
+  applyKeyLedMap();   // Defaults until loadKeyLedMap() runs; clears the strip
 
   // Start dark; they'll light when we learn populated/off/on status
   keyPixels.show();
 
-  debugPrintf("Key LED strip ready on pin %d with %d pixels", EXECUTOR_LED_PIN, EXECUTOR_LED_COUNT);
+  debugPrintf("Key LED strip ready on pin %d with %d mapped pixels", EXECUTOR_LED_PIN, keyPixelFirst[NUM_EXECUTORS_TRACKED]);
   
 }
 
 void markKeyLedsDirty() {
-  keyLedsDirty = true;
+  keyDirtyMask = ALL_KEYS_MASK;
+}
+
+void markKeyLedDirty(int execIndex) {
+  if (execIndex < 0 || execIndex >= NUM_EXECUTORS_TRACKED) {
+    return;
+  }
+  keyDirtyMask |= 1ULL << execIndex;
 }
 
+void predictKeyPress(int execIndex) {
+  if (execIndex < 0 || execIndex >= NUM_EXECUTORS_TRACKED) {
+    return;
+  }
+
+  // Keystroke mode gets no OSC status back, so a prediction could never be confirmed
+  if (Fconfig.sendKeystrokes) {
+    return;
+  }
+
+  // Only off -> on is safe to show early. An on key may stay on (Go+, Flash), and
+  // showing it off would blink when the console confirms; empty keys do nothing.
+  KeyPrediction& p = keyPredictions[execIndex];
+  if (p.active || executorStatus[execIndex] != 1) {
+    return;
+  }
+
+  p.active = true;
+  p.status = 2;
+  p.confirmSeq = consoleLinkNextPingSeq();
+  p.startMs = millis();
+  p.confirmedMs = 0;
+  predictionStats.predicted++;
+  predictionMask |= 1ULL << execIndex;
+
+  consoleLinkPingSoon();
+  markKeyLedDirty(execIndex);
+}
+
+// Drop predictions the console agreed with, revert the ones it did not
+static void reconcileKeyPredictions() {
+  if (predictionMask == 0) {
+    return;
+  }
+
+  const uint32_t now = millis();
+  const bool useConfirm = consoleLinkHasPongs();
+
+  for (uint64_t pending = predictionMask; pending != 0; pending &= pending - 1) {
+    const int i = __builtin_ctzll(pending);
+    KeyPrediction& p = keyPredictions[i];
+
+    if (executorStatus[i] == p.status) {
+      p.active = false;
+      predictionMask &= ~(1ULL << i);
+      predictionStats.confirmed++;
+      continue;
+    }
+
+    const uint32_t age = now - p.startMs;
+    bool settled;
+    if (useConfirm) {
+      if (p.confirmedMs == 0 && consoleLinkConfirms(p.confirmSeq)) {
+        p.confirmedMs = now;
+      }
+      settled = p.confirmedMs != 0 && now - p.confirmedMs >= KEY_PREDICTION_GRACE_MS;
+    } else {
+      settled = age >= KEY_PREDICTION_HOLDOFF_MS;
+    }
+
+    if (settled || age >= KEY_PREDICTION_MAX_MS) {
+      p.active = false;
+      predictionMask &= ~(1ULL << i);
+      predictionStats.reverted++;
+      markKeyLedDirty(i);
+    }
+  }
+}
+
+const KeyLedPredictionStats& getKeyLedPredictionStats() {
+  return predictionStats;
+}
+
+// Called once per LED frame, so any number of changes between frames cost one push
 void updateKeyLeds() {
-  if (!keyLedsDirty) {
+  reconcileKeyPredictions();
+
+  keyDitherFrame++;
+  keyDirtyMask |= ditheredKeyMask;
+  if (keyDirtyMask == 0) {
     return;
   }
 
-  keyLedsDirty = false;
+  const uint64_t dirty = keyDirtyMask;
+  keyDirtyMask = 0;
+  bool changed = false;
 
-  for (int i = 0; i < NUM_EXECUTORS_TRACKED; ++i) {
-    uint8_t status = executorStatus[i]; // 0=empty,1=populated off,2=on
+  for (uint64_t pending = dirty; pending != 0; pending &= pending - 1) {
+    const int i = __builtin_ctzll(pending);
+    // 0=empty,1=populated off,2=on
+    uint8_t status = keyPredictions[i].active ? keyPredictions[i].status : executorStatus[i];
     uint8_t brightness = 0;
 
     if (status == 2) {
@@ -102,8 +276,12 @@ void updateKeyLeds() {
       brightness = 0;
     }
 
-    fillExecutorPixels(i, brightness);
+    if (fillExecutorPixels(i, brightness)) {
+      changed = true;
+    }
   }
 
-  keyPixels.show();
+  if (changed) {
+    keyPixels.show();
+  }
 }
@@ -0,0 +1,229 @@
+// LedAnimation.cpp
+
+#include "LedAnimation.h"
+#include "ColorMath.h"
+#include <string.h>
+
+//================================
+// SETTINGS
+//================================
+
+static constexpr uint32_t WAVE_FADE_IN_PERCENT = 30;    // Of the color cycle
+static constexpr uint32_t WAVE_SETTLE_MS = 250;         // Blend from the wave into the fader's own color
+
+// (sin(2 pi i / 256) + 1) / 2 * 255: one breathing cycle of the startup wave
+static const uint8_t WAVE_BREATHE[256] = {
+  128, 131, 134, 137, 140, 143, 146, 149, 152, 155, 158, 162, 165, 167, 170, 173,
+  176, 179, 182, 185, 188, 190, 193, 196, 198, 201, 203, 206, 208, 211, 213, 215,
+  218, 220, 222, 224, 226, 228, 230, 232, 234, 235, 237, 238, 240, 241, 243, 244,
+  245, 246, 248, 249, 250, 250, 251, 252, 253, 253, 254, 254, 254, 255, 255, 255,
+  255, 255, 255, 255, 254, 254, 254, 253, 253, 252, 251, 250, 250, 249, 248, 246,
+  245, 244, 243, 241, 240, 238, 237, 235, 234, 232, 230, 228, 226, 224, 222, 220,
+  218, 215, 213, 211, 208, 206, 203, 201, 198, 196, 193, 190, 188, 185, 182, 179,
+  176, 173, 170, 167, 165, 162, 158, 155, 152, 149, 146, 143, 140, 137, 134, 131,
+  128, 124, 121, 118, 115, 112, 109, 106, 103, 100,  97,  93,  90,  88,  85,  82,
+   79,  76,  73,  70,  67,  65,  62,  59,  57,  54,  52,  49,  47,  44,  42,  40,
+   37,  35,  33,  31,  29,  27,  25,  23,  21,  20,  18,  17,  15,  14,  12,  11,
+   10,   9,   7,   6,   5,   5,   4,   3,   2,   2,   1,   1,   1,   0,   0,   0,
+    0,   0,   0,   0,   1,   1,   1,   2,   2,   3,   4,   5,   5,   6,   7,   9,
+   10,  11,  12,  14,  15,  17,  18,  20,  21,  23,  25,  27,  29,  31,  33,  35,
+   37,  40,  42,  44,  47,  49,  52,  54,  57,  59,  62,  65,  67,  70,  73,  76,
+   79,  82,  85,  88,  90,  93,  97, 100, 103, 106, 109, 112, 115, 118, 121, 124
+};
+
+//================================
+// STATE
+//================================
+
+struct LedAnimation {
+  uint8_t  type;          // LedAnimationType
+  bool     started;       // Clock running (set on the first step)
+  uint32_t startMs;
+  uint32_t order;         // Higher started later and wins on shared faders
+  uint16_t faderMask;
+  // Startup wave
+  uint16_t staggerMs;
+  uint16_t cycleMs;
+  // Flash
+  uint32_t color;
+  uint8_t  count;
+  uint16_t onMs;
+  uint16_t offMs;
+};
+
+static LedAnimation slots[LED_ANIMATION_SLOTS];
+static uint32_t orderCounter = 0;
+static uint32_t frameMs = 0;
+
+//================================
+// SLOTS
+//================================
+
+// Restart an effect of the same kind, else take a free slot, else replace the oldest
+static LedAnimation& claimSlot(uint8_t type) {
+  LedAnimation* slot = nullptr;
+  for (uint8_t i = 0; i < LED_ANIMATION_SLOTS && !slot; i++) {
+    if (slots[i].type == type) slot = &slots[i];
+  }
+  for (uint8_t i = 0; i < LED_ANIMATION_SLOTS && !slot; i++) {
+    if (slots[i].type == LED_ANIM_NONE) slot = &slots[i];
+  }
+  if (!slot) {
+    slot = &slots[0];
+    for (uint8_t i = 1; i < LED_ANIMATION_SLOTS; i++) {
+      if (slots[i].order < slot->order) slot = &slots[i];
+    }
+  }
+
+  memset(slot, 0, sizeof(LedAnimation));
+  slot->type = type;
+  slot->order = ++orderCounter;
+  return *slot;
+}
+
+void startStartupWave(uint16_t staggerMs, uint16_t cycleMs) {
+  LedAnimation& a = claimSlot(LED_ANIM_STARTUP_WAVE);
+  a.faderMask = ALL_FADERS_MASK;
+  a.staggerMs = staggerMs;
+  a.cycleMs = max(cycleMs, (uint16_t)1);
+}
+
+void startFaderFlash(uint16_t faderMask, uint32_t color, uint8_t count, uint16_t onMs, uint16_t offMs) {
+  LedAnimation& a = claimSlot(LED_ANIM_FLASH);
+  a.faderMask = faderMask & ALL_FADERS_MASK;
+  a.color = color;
+  a.count = count;
+  a.onMs = onMs;
+  a.offMs = offMs;
+}
+
+//================================
+// TIMELINE
+//================================
+
+static uint32_t animationLength(const LedAnimation& a) {
+  switch (a.type) {
+    case LED_ANIM_STARTUP_WAVE:
+      return (uint32_t)(NUM_FADERS - 1) * a.staggerMs + a.cycleMs + WAVE_SETTLE_MS;
+    case LED_ANIM_FLASH:
+      return (uint32_t)a.count * (a.onMs + a.offMs);
+    default:
+      return 0;
+  }
+}
+
+void stepLedAnimations(uint32_t now) {
+  frameMs = now;
+  for (uint8_t i = 0; i < LED_ANIMATION_SLOTS; i++) {
+    LedAnimation& a = slots[i];
+    if (a.type == LED_ANIM_NONE) continue;
+
+    if (!a.started) {
+      a.started = true;
+      a.startMs = now;
+    }
+    if (now - a.startMs >= animationLength(a)) {
+      a.type = LED_ANIM_NONE;
+    }
+  }
+}
+
+bool ledAnimationsActive() {
+  for (uint8_t i = 0; i < LED_ANIMATION_SLOTS; i++) {
+    if (slots[i].type != LED_ANIM_NONE) return true;
+  }
+  return false;
+}
+
+//================================
+// EFFECTS
+//================================
+
+// Fully saturated hue, position 0-1535 around the wheel
+static void hueToRgb(uint32_t hue, uint8_t& r, uint8_t& g, uint8_t& b) {
+  const uint8_t rise = hue & 0xFF;
+  const uint8_t fall = 255 - rise;
+  switch ((hue >> 8) % 6) {
+    case 0:  r = 255;  g = rise; b = 0;    break;
+    case 1:  r = fall; g = 255;  b = 0;    break;
+    case 2:  r = 0;    g = 255;  b = rise; break;
+    case 3:  r = 0;    g = fall; b = 255;  break;
+    case 4:  r = rise; g = 0;    b = 255;  break;
+    default: r = 255;  g = 0;    b = fall; break;
+  }
+}
+
+static bool waveColor(const LedAnimation& a, int faderIndex, uint32_t elapsed, uint32_t& color) {
+  const uint32_t faderStart = (uint32_t)faderIndex * a.staggerMs;
+  if (elapsed < faderStart) {
+    color = 0;   // Not reached yet
+    return true;
+  }
+
+  const uint32_t t = elapsed - faderStart;
+  const Fader& f = faders[faderIndex];
+
+  if (t < a.cycleMs) {
+    // One trip round the color wheel, breathing, fading in over the first part
+    uint8_t r, g, b;
+    hueToRgb(t * 1536 / a.cycleMs, r, g, b);
+    const uint32_t breathe = WAVE_BREATHE[t * 256 / a.cycleMs];
+    const uint32_t fadeIn = min((uint32_t)256, t * 100 * 256 / (a.cycleMs * WAVE_FADE_IN_PERCENT));
+    const uint8_t brightness = (uint8_t)(scale8(Fconfig.touchedBrightness, breathe) * fadeIn >> 8);
+    color = scaleColorToBrightness(r, g, b, brightness);
+    return true;
+  }
+
+  if (t < a.cycleMs + WAVE_SETTLE_MS) {
+    // The wheel ends on red: blend into the fader's color while dimming to base brightness
+    const uint32_t p = (t - a.cycleMs) * 256 / WAVE_SETTLE_MS;
+    const uint8_t r = (uint8_t)((255 * (256 - p) + f.red * p) >> 8);
+    const uint8_t g = (uint8_t)((f.green * p) >> 8);
+    const uint8_t b = (uint8_t)((f.blue * p) >> 8);
+    const uint8_t brightness = (uint8_t)((Fconfig.touchedBrightness * (256 - p) + Fconfig.baseBrightness * p) >> 8);
+    color = scaleColorToBrightness(r, g, b, brightness);
+    return true;
+  }
+
+  return false;
+}
+
+static bool flashColor(const LedAnimation& a, uint32_t elapsed, uint32_t& color) {
+  const uint32_t period = a.onMs + a.offMs;
+  if (period == 0 || elapsed % period >= a.onMs) {
+    return false;   // Off phase shows normal rendering
+  }
+  color = a.color;
+  return true;
+}
+
+bool getFaderAnimationColor(int faderIndex, uint32_t& color) {
+  if (faderIndex < 0 || faderIndex >= NUM_FADERS) return false;
+
+  const LedAnimation* winner = nullptr;
+  uint32_t winnerColor = 0;
+
+  for (uint8_t i = 0; i < LED_ANIMATION_SLOTS; i++) {
+    const LedAnimation& a = slots[i];
+    if (a.type == LED_ANIM_NONE || !a.started || !(a.faderMask & (1U << faderIndex))) continue;
+    if (winner && a.order < winner->order) continue;
+
+    const uint32_t elapsed = frameMs - a.startMs;
+    uint32_t c;
+    bool painted = false;
+    if (a.type == LED_ANIM_STARTUP_WAVE) {
+      painted = waveColor(a, faderIndex, elapsed, c);
+    } else if (a.type == LED_ANIM_FLASH) {
+      painted = flashColor(a, elapsed, c);
+    }
+
+    if (painted) {
+      winner = &a;
+      winnerColor = c;
+    }
+  }
+
+  if (!winner) return false;
+  color = winnerColor;
+  return true;
+}
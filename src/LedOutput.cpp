@@ -0,0 +1,139 @@
+// LedOutput.cpp
+
+#include "LedOutput.h"
+
+static_assert(NUM_PIXELS <= LED_STRIP_LENGTH, "Fader strip longer than LED_STRIP_LENGTH");
+static_assert(EXECUTOR_LED_COUNT <= LED_STRIP_LENGTH, "Key strip longer than LED_STRIP_LENGTH");
+
+//================================
+// GLOBAL LED ENGINE
+//================================
+
+static constexpr uint32_t LED_FRAME_INTERVAL_US = 1000000UL / LED_FRAME_RATE;
+
+// Same order as LedOutputIndex
+static const uint8_t LED_OUTPUT_PINS[LED_OUTPUT_COUNT] = { NEOPIXEL_PIN, EXECUTOR_LED_PIN };
+
+// 3 bytes per pixel per output. DMA reads the frame buffer while the next frame
+// is drawn; DMAMEM keeps it out of the tightly coupled RAM.
+static constexpr size_t LED_BUFFER_WORDS = (LED_STRIP_LENGTH * LED_OUTPUT_COUNT * 3 + 3) / 4;
+DMAMEM static int ledFrameBuffer[LED_BUFFER_WORDS];
+static int ledDrawBuffer[LED_BUFFER_WORDS];
+
+LedEngine ledEngine(LED_OUTPUT_PINS, LED_OUTPUT_COUNT, LED_STRIP_LENGTH, ledFrameBuffer, ledDrawBuffer);
+
+//================================
+// ENGINE
+//================================
+
+LedEngine::LedEngine(const uint8_t* pins, uint8_t numOutputs, uint16_t pixelsPerOutput, int* frameBuf, int* drawBuf)
+  : perOutput(pixelsPerOutput),
+    outputs(numOutputs),
+    leds(pixelsPerOutput, frameBuf, drawBuf, WS2811_RGB | WS2811_800kHz, numOutputs, pins) {
+}
+
+void LedEngine::begin() {
+  if (started) return;
+  leds.begin();
+  started = true;
+}
+
+// Only touches the draw buffer, never the frame DMA is sending
+void LedEngine::setPixel(uint8_t output, uint16_t n, uint32_t color) {
+  if (output >= outputs || n >= perOutput) return;
+  leds.setPixel((uint32_t)output * perOutput + n, (int)color);
+}
+
+uint32_t LedEngine::getPixel(uint8_t output, uint16_t n) {
+  if (output >= outputs || n >= perOutput) return 0;
+  return (uint32_t)leds.getPixel((uint32_t)output * perOutput + n);
+}
+
+bool LedEngine::busy() {
+  return leds.busy();
+}
+
+bool LedEngine::beginFrame() {
+  const uint32_t now = micros();
+  if ((int32_t)(now - nextFrameUs) < 0) return false;
+
+  // Fixed slots; after a long stall start again from now instead of catching up
+  nextFrameUs += LED_FRAME_INTERVAL_US;
+  if ((int32_t)(now - nextFrameUs) >= 0) {
+    nextFrameUs = now + LED_FRAME_INTERVAL_US;
+  }
+
+  batching = true;
+  frameStartUs = now;
+  return true;
+}
+
+void LedEngine::endFrame() {
+  batching = false;
+  rendered++;
+  renderUs = micros() - frameStartUs;
+  if (renderUs > renderMaxUs) renderMaxUs = renderUs;
+  if (!dirty) return;
+
+  // OctoWS2811::show() would wait out the frame in flight; try again next loop instead
+  if (leds.busy()) {
+    deferred++;
+    return;
+  }
+  transmit();
+}
+
+void LedEngine::show() {
+  dirty = true;
+  if (batching || !started) return;
+
+  while (leds.busy()) {
+  }
+  transmit();
+}
+
+void LedEngine::transmit() {
+  leds.show();
+  dirty = false;
+  shown++;
+}
+
+//================================
+// STRIP VIEW
+//================================
+
+LedStrip::LedStrip(LedEngine& engine, uint8_t output, uint16_t numPixels)
+  : engine(engine), output(output), count(numPixels) {
+}
+
+void LedStrip::begin() {
+  engine.begin();
+}
+
+void LedStrip::clear() {
+  for (uint16_t i = 0; i < count; i++) {
+    engine.setPixel(output, i, 0);
+  }
+}
+
+void LedStrip::setPixelColor(uint16_t n, uint32_t color) {
+  if (n >= count) return;
+  engine.setPixel(output, n, color);
+}
+
+void LedStrip::setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+  setPixelColor(n, Color(r, g, b));
+}
+
+uint32_t LedStrip::getPixelColor(uint16_t n) {
+  if (n >= count) return 0;
+  return engine.getPixel(output, n);
+}
+
+void LedStrip::show() {
+  engine.show();
+}
+
+bool LedStrip::canShow() {
+  return !engine.busy();
+}
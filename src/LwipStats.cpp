@@ -0,0 +1,73 @@
+// LwipStats.cpp
+
+#include "LwipStats.h"
+#include <string.h>
+
+#include "lwip/opt.h"
+#include "lwip/memp.h"
+#include "lwip/stats.h"
+
+#if LWIP_STATS && MEMP_STATS
+// Pool names come from lwIP's own pool list, stats_mem only carries them in debug builds
+static const char* const kPoolNames[] = {
+#define LWIP_MEMPOOL(name, num, size, desc) desc,
+#include "lwip/priv/memp_std.h"
+};
+#endif
+
+uint8_t getLwipPoolCount() {
+#if LWIP_STATS && MEMP_STATS
+  return MEMP_MAX;
+#else
+  return 0;
+#endif
+}
+
+bool getLwipPoolStats(uint8_t index, LwipPoolStats& out) {
+  memset(&out, 0, sizeof(out));
+#if LWIP_STATS && MEMP_STATS
+  if (index >= MEMP_MAX || lwip_stats.memp[index] == nullptr) {
+    return false;
+  }
+  const struct stats_mem* pool = lwip_stats.memp[index];
+  out.name = kPoolNames[index];
+  out.used = pool->used;
+  out.max = pool->max;
+  out.avail = pool->avail;
+  out.err = pool->err;
+  return true;
+#else
+  (void)index;
+  return false;
+#endif
+}
+
+void getLwipStackStats(LwipStackStats& out) {
+  memset(&out, 0, sizeof(out));
+#if LWIP_STATS
+#if MEM_STATS
+  out.heapUsed = lwip_stats.mem.used;
+  out.heapMax = lwip_stats.mem.max;
+  out.heapAvail = lwip_stats.mem.avail;
+  out.heapErr = lwip_stats.mem.err;
+#endif
+#if LINK_STATS
+  out.linkDrops = lwip_stats.link.drop;
+#endif
+#if UDP_STATS
+  out.udpRecv = lwip_stats.udp.recv;
+  out.udpXmit = lwip_stats.udp.xmit;
+  out.udpDrops = lwip_stats.udp.drop;
+  out.udpMemErrors = lwip_stats.udp.memerr;
+#endif
+#if TCP_STATS
+  out.tcpRecv = lwip_stats.tcp.recv;
+  out.tcpXmit = lwip_stats.tcp.xmit;
+  out.tcpDrops = lwip_stats.tcp.drop;
+  out.tcpMemErrors = lwip_stats.tcp.memerr;
+#endif
+#if MIB2_STATS
+  out.tcpRetransmits = lwip_stats.mib2.tcpretranssegs;
+#endif
+#endif
+}
@@ -3,17 +3,23 @@
 #include "NeoPixelControl.h"
 #include "Utils.h"
 #include "FaderControl.h"
+#include "ColorMath.h"
+#include "LedAnimation.h"
+#include "KeyLedControl.h"
+#include "SacnReceiver.h"
 #include <stdint.h>  // or <cstdint>
-#include <cmath>
 
 //NeoPixel Debug print
 bool neoPixelDebug = false;
 
+static uint8_t ditherFrame = 0;
+static uint32_t ditheredFrames = 0;
+
 //================================
 // GLOBAL NEOPIXEL OBJECT
 //================================
 
-Adafruit_NeoPixel pixels(NUM_PIXELS, NEOPIXEL_PIN, NEO_RGB + NEO_KHZ800);
+LedStrip pixels(ledEngine, LED_OUTPUT_FADERS, NUM_PIXELS);
 
 
 //================================
@@ -21,6 +27,7 @@ Adafruit_NeoPixel pixels(NUM_PIXELS, NEOPIXEL_PIN, NEO_RGB + NEO_KHZ800);
 //================================
 
 void setupNeoPixels() {
+  initGammaTables();
   pixels.begin();  // Initialize the NeoPixel strip
   pixels.clear();  // Turn off all pixels
   pixels.show();   // Apply changes
@@ -30,53 +37,119 @@ void setupNeoPixels() {
     faders[i].red = 255;     // white
     faders[i].green = 255;
     faders[i].blue = 255;
-    faders[i].lastRenderedColor = 0xFFFFFFFF; // force initial render
-    faders[i].lastRenderedSetpoint = 255;     // force initial render
     //faders[i].colorUpdated = true;  // Force initial update
   }
+  markFaderLedsDirty();  // force initial render
+}
+
+// Redraw every fader segment on the next update, after something drew over them directly
+void markFaderLedsDirty() {
+  for (int i = 0; i < NUM_FADERS; i++) {
+    faders[i].lastRenderedColor = 0xFFFFFFFF;  // Never a real color (top byte unused)
+    faders[i].lastRenderedSetpoint = 255;
+  }
 }
 
 //================================
 // MAIN UPDATE FUNCTION
 //================================
 
+// One LED frame when the scheduler says one is due: effects, fader strip, key strip, one transfer
+void renderLedFrame() {
+  if (!ledEngine.beginFrame()) {
+    return;
+  }
+  stepLedAnimations(millis());
+  updateSacnInput();
+  updateNeoPixels();
+  updateKeyLeds();
+  ledEngine.endFrame();
+}
+
+// Only segments whose color (or level) changed are redrawn; the strip is pushed only if one was
 void updateNeoPixels() {
   unsigned long now = millis();
   bool pixelsDirty = false;
+  bool anyDithered = false;
+  ditherFrame++;
+
+  static bool renderedLevelMode = false;
+  if (Fconfig.useLevelPixels != renderedLevelMode) {
+    renderedLevelMode = Fconfig.useLevelPixels;
+    markFaderLedsDirty();
+  }
 
   for (int i = 0; i < NUM_FADERS; i++) {
     Fader& f = faders[i];
 
-    // Calculate fade progress for brightness transitions
+    // Fades run in perceptual level at 16 bits; the dark end is dithered across frames
+    uint16_t channels16[3] = {0, 0, 0};
+    bool fading = false;
     if (f.currentBrightness != f.targetBrightness) {
       unsigned long elapsed = now - f.brightnessStartTime;
-      if (elapsed >= Fconfig.fadeTime) {
+      if (elapsed >= f.fadeDuration) {
         f.currentBrightness = f.targetBrightness;
       } else {
-        float progress = elapsed / (float)Fconfig.fadeTime;
-        int start = f.currentBrightness;
-        int delta = (int)f.targetBrightness - start;
-        f.currentBrightness = start + (int)(delta * progress);
+        // |fadeRate * elapsed| stays below span * 4096, so this fits in 32 bits
+        f.fadeLevel = (uint16_t)(f.fadeStartLevel + ((f.fadeRate * (int32_t)elapsed) >> 12));
+        const uint16_t brightness16 = linearFromPerceptual(f.fadeLevel);
+        f.currentBrightness = brightness16 >> 8;
+        scaleColorToBrightness16(f.red, f.green, f.blue, brightness16, channels16);
+        fading = true;
+      }
+    }
+
+    // A running effect paints the whole segment; fades above keep going underneath
+    uint32_t effectColor;
+    if (getFaderAnimationColor(i, effectColor)) {
+      if (effectColor != f.lastRenderedColor || f.lastRenderedSetpoint != 255) {
+        for (int j = 0; j < PIXELS_PER_FADER; j++) {
+          pixels.setPixelColor(i * PIXELS_PER_FADER + j, effectColor);
+        }
+        f.lastRenderedColor = effectColor;
+        f.lastRenderedSetpoint = 255;   // Level mode redraws once the effect ends
+        pixelsDirty = true;
       }
+      continue;
+    }
+
+    // Settled low levels can keep the fraction too, so dim mixed colors hold their hue.
+    // Off by default: a dithered fader is redrawn and pushed every frame.
+    if (!fading && Fconfig.ditherDimColors && f.currentBrightness < LED_DITHER_BELOW_LEVEL) {
+      scaleColorToBrightness16(f.red, f.green, f.blue, (uint16_t)f.currentBrightness << 8, channels16);
+    }
+
+    uint32_t color;
+    bool dithered = needsDither(channels16);
+    if (fading || dithered) {
+      color = ((uint32_t)(channels16[0] >> 8) << 16) | ((uint32_t)(channels16[1] >> 8) << 8) | (channels16[2] >> 8);
+    } else {
+      color = getScaledColor(f);
     }
 
-    uint32_t color = getScaledColor(f);
-    bool needsUpdate = false;
+    // sACN input merges with (or replaces) the appearance color
+    if (mergeSacnFaderColor(i, color)) {
+      dithered = false;
+    }
+    anyDithered |= dithered;
 
     if (neoPixelDebug && f.currentBrightness != f.lastReportedBrightness) {
-      uint8_t r = (f.red * f.currentBrightness) / 255;
-      uint8_t g = (f.green * f.currentBrightness) / 255;
-      uint8_t b = (f.blue * f.currentBrightness) / 255;
+      uint8_t r = scale8(f.red, f.currentBrightness);
+      uint8_t g = scale8(f.green, f.currentBrightness);
+      uint8_t b = scale8(f.blue, f.currentBrightness);
       debugPrintf("Fader %d RGB → R=%d G=%d B=%d (Brightness=%d)",
                   i, r, g, b, f.currentBrightness);
       f.lastReportedBrightness = f.currentBrightness;
     }
 
     if (!Fconfig.useLevelPixels) {
-      needsUpdate = (color != f.lastRenderedColor);
+      if (!dithered && color == f.lastRenderedColor) {
+        continue;
+      }
       // Legacy mode: fill all pixels for this fader with the scaled color
       for (int j = 0; j < PIXELS_PER_FADER; j++) {
-        pixels.setPixelColor(i * PIXELS_PER_FADER + j, color);
+        uint32_t pixelColor = dithered ? ditherColor16(channels16, ditherFrame + j * 5) : color;
+        pixels.setPixelColor(i * PIXELS_PER_FADER + j, pixelColor);
       }
     } else {
       // Level mode: light up pixels per side based on current fader position (0-100)
@@ -85,7 +158,9 @@ void updateNeoPixels() {
       // Round to nearest and clamp so the bottom pixel stays lit
       int litPerSide = (oscValue * 12 + 50) / 100;  // map 0-100 to 0-12 (rounded)
       litPerSide = constrain(litPerSide, 1, 12);    // always show at least the bottom pixel
-      needsUpdate = (color != f.lastRenderedColor) || (f.lastRenderedSetpoint != (uint8_t)oscValue);
+      if (!dithered && color == f.lastRenderedColor && f.lastRenderedSetpoint == (uint8_t)oscValue) {
+        continue;
+      }
 
       for (int j = 0; j < PIXELS_PER_FADER; j++) {
         bool isLit = false;
@@ -96,15 +171,19 @@ void updateNeoPixels() {
           int rel = j - 12;           // right side, bottom = rel 0
           isLit = rel < litPerSide;
         }
-        pixels.setPixelColor(i * PIXELS_PER_FADER + j, isLit ? color : pixels.Color(0, 0, 0));
+        uint32_t pixelColor = dithered ? ditherColor16(channels16, ditherFrame + j * 5) : color;
+        pixels.setPixelColor(i * PIXELS_PER_FADER + j, isLit ? pixelColor : pixels.Color(0, 0, 0));
       }
       f.lastRenderedSetpoint = (uint8_t)oscValue;
     }
 
-    if (needsUpdate) {
-      f.lastRenderedColor = color;
-      pixelsDirty = true;
-    }
+    // A dithered segment changes every frame, and must be redrawn once it settles
+    f.lastRenderedColor = dithered ? 0xFFFFFFFF : color;
+    pixelsDirty = true;
+  }
+
+  if (anyDithered || keyLedsDithering()) {
+    ditheredFrames++;
   }
 
   // Push to strip when something changed
@@ -113,6 +192,24 @@ void updateNeoPixels() {
   }
 }
 
+// Continue from where a running fade has got to, otherwise from the settled brightness.
+// The one division happens here; frames only multiply by the rate.
+static void startBrightnessFade(Fader& f, uint8_t target, unsigned long now) {
+  f.fadeStartLevel = (f.currentBrightness != f.targetBrightness) ? f.fadeLevel : perceptualLevel(f.currentBrightness);
+  f.fadeLevel = f.fadeStartLevel;
+  f.brightnessStartTime = now;
+  f.targetBrightness = target;
+  f.fadeDuration = Fconfig.fadeTime;
+  if (f.fadeDuration > 0) {
+    const int32_t span = (int32_t)perceptualLevel(target) - f.fadeStartLevel;
+    f.fadeRate = (int32_t)((int64_t)span * 4096 / (int64_t)f.fadeDuration);
+  }
+}
+
+uint32_t getDitheredFrameCount() {
+  return ditheredFrames;
+}
+
 void updateBrightnessOnFaderTouchChange() {
   static bool previousTouch[NUM_FADERS] = { false };
 
@@ -121,8 +218,7 @@ void updateBrightnessOnFaderTouchChange() {
     bool currentTouch = f.touched;
 
     if (currentTouch != previousTouch[i]) {
-      f.brightnessStartTime = millis();
-      f.targetBrightness = currentTouch ? Fconfig.touchedBrightness : Fconfig.baseBrightness;
+      startBrightnessFade(f, currentTouch ? Fconfig.touchedBrightness : Fconfig.baseBrightness, millis());
 
       if (neoPixelDebug){
           debugPrintf("Fader %d → Touch %s → Brightness target = %d", i,
@@ -143,8 +239,7 @@ void updateBaseBrightnessPixels() {
   for (int i = 0; i < NUM_FADERS; i++) {
     Fader& f = faders[i];
     if (!f.touched) {
-      f.brightnessStartTime = now;
-      f.targetBrightness = Fconfig.baseBrightness;
+      startBrightnessFade(f, Fconfig.baseBrightness, now);
       // Optionally, set currentBrightness directly if no fade desired:
       // f.currentBrightness = Fconfig.baseBrightness;
 
@@ -161,216 +256,29 @@ void updateBaseBrightnessPixels() {
 // Color functions
 //================================
 
-// Converts RGB to HSV and scales value, then returns scaled RGB color
-uint32_t getScaledColor(const Fader& fader) {
-  // Special case: if original color is black (0,0,0), keep it black
-  if (fader.red == 0 && fader.green == 0 && fader.blue == 0) {
-    return pixels.Color(0, 0, 0);  // Always return black regardless of brightness
+// Scales the fader color so its brightest channel equals currentBrightness (hue preserved).
+// Memoized per fader: recomputed only when the color or brightness changes.
+uint32_t getScaledColor(Fader& fader) {
+  const uint32_t key = ((uint32_t)fader.red << 24) | ((uint32_t)fader.green << 16) |
+                       ((uint32_t)fader.blue << 8) | fader.currentBrightness;
+  if (key != fader.scaledColorKey) {
+    fader.scaledColorKey = key;
+    fader.scaledColor = scaleColorToBrightness(fader.red, fader.green, fader.blue, fader.currentBrightness);
   }
-
-  float r = fader.red / 255.0f;
-  float g = fader.green / 255.0f;
-  float b = fader.blue / 255.0f;
-
-  float cmax = std::max(r, std::max(g, b));
-  float cmin = std::min(r, std::min(g, b));
-  float delta = cmax - cmin;
-
-  float h = 0, s = 0;//, v = cmax;  //we are not using value in HSV, we are using fader.currentBrightness as v
-
-  if (delta != 0) {
-    if (cmax == r) h = fmodf(((g - b) / delta), 6.0f);
-    else if (cmax == g) h = ((b - r) / delta) + 2.0f;
-    else h = ((r - g) / delta) + 4.0f;
-
-    h *= 60.0f;
-    if (h < 0) h += 360.0f;
-  }
-
-  if (cmax != 0) s = delta / cmax;
-
-  float scaledV = fader.currentBrightness / 255.0f;
-
-  float c = scaledV * s;
-  float x = c * (1 - fabsf(fmodf(h / 60.0f, 2) - 1));
-  float m = scaledV - c;
-
-  float r1 = 0, g1 = 0, b1 = 0;
-
-  if (h < 60)      { r1 = c; g1 = x; }
-  else if (h < 120){ r1 = x; g1 = c; }
-  else if (h < 180){ g1 = c; b1 = x; }
-  else if (h < 240){ g1 = x; b1 = c; }
-  else if (h < 300){ r1 = x; b1 = c; }
-  else             { r1 = c; b1 = x; }
-
-  return pixels.Color(
-    (uint8_t)((r1 + m) * 255),
-    (uint8_t)((g1 + m) * 255),
-    (uint8_t)((b1 + m) * 255)
-  );
+  return fader.scaledColor;
 }
 
 
 
+//================================
+// EFFECTS
+//================================
+
+// Boot / calibration sweep, plays over normal rendering (see LedAnimation.h)
 void fadeSequence(unsigned long STAGGER_DELAY, unsigned long COLOR_CYCLE_TIME) {
-  
-  unsigned long startTime = millis();
-  bool animationComplete = false;
-  uint8_t originalColors[NUM_FADERS][3];
-  
-  // Start all faders at black (0,0,0) with zero brightness
-  for (int i = 0; i < NUM_FADERS; i++) {
-    
-    originalColors[i][0] = faders[i].red;
-    originalColors[i][1] = faders[i].green;
-    originalColors[i][2] = faders[i].blue;
-    
-
-    faders[i].currentBrightness = 0;
-    faders[i].red = 0;
-    faders[i].green = 0;
-    faders[i].blue = 0;
-  }
-  
-  while (!animationComplete) {
-    unsigned long now = millis();
-    animationComplete = true;
-    
-    for (int i = 0; i < NUM_FADERS; i++) {
-      unsigned long faderStartTime = startTime + (i * STAGGER_DELAY);
-      
-      if (now >= faderStartTime) {
-        unsigned long elapsed = now - faderStartTime;
-        
-        if (elapsed < COLOR_CYCLE_TIME) {
-          // Color wave is active on this fader
-          animationComplete = false;
-          
-          // Calculate color transition through rainbow spectrum
-          float colorProgress = (elapsed % COLOR_CYCLE_TIME) / (float)COLOR_CYCLE_TIME;
-          float hue = colorProgress * 360.0; // Full rainbow cycle
-          
-          // Convert HSV to RGB (Hue, Saturation=1, Value=1)
-          float c = 1.0; // Saturation at max
-          float x = c * (1.0 - fabs(fmod(hue / 60.0, 2.0) - 1.0));
-          float m = 0.0;
-          
-          float r1, g1, b1;
-          if (hue < 60)      { r1 = c; g1 = x; b1 = 0; }
-          else if (hue < 120){ r1 = x; g1 = c; b1 = 0; }
-          else if (hue < 180){ r1 = 0; g1 = c; b1 = x; }
-          else if (hue < 240){ r1 = 0; g1 = x; b1 = c; }
-          else if (hue < 300){ r1 = x; g1 = 0; b1 = c; }
-          else             { r1 = c; g1 = 0; b1 = x; }
-          
-          // Set the color
-          faders[i].red = (uint8_t)((r1 + m) * 255);
-          faders[i].green = (uint8_t)((g1 + m) * 255);
-          faders[i].blue = (uint8_t)((b1 + m) * 255);
-          
-          // Calculate brightness with breathing effect
-          float breatheProgress = (elapsed % COLOR_CYCLE_TIME) / (float)COLOR_CYCLE_TIME;
-          float breatheValue = (sin(breatheProgress * PI * 2) + 1.0) / 2.0; // Sine wave 0-1
-          
-          // Combine with fade-in effect
-          float fadeProgress = min(1.0f, elapsed / (float)(COLOR_CYCLE_TIME * 0.3)); // Fade in over first 30%
-          
-          int targetBrightness = Fconfig.touchedBrightness;
-          faders[i].currentBrightness = (uint8_t)(targetBrightness * breatheValue * fadeProgress);
-          
-        } else {
-          // Wave has passed, fade out with color shift to original color
-          unsigned long fadeOutTime = elapsed - COLOR_CYCLE_TIME;
-          const unsigned long FADE_OUT_DURATION = 250; // 250ms fade out
-          
-          if (fadeOutTime < FADE_OUT_DURATION) {
-            animationComplete = false;
-            
-            // Fade to original color while dimming
-            float fadeProgress = fadeOutTime / (float)FADE_OUT_DURATION;
-            
-            // Blend current color to original color
-            uint8_t currentR = faders[i].red;
-            uint8_t currentG = faders[i].green;
-            uint8_t currentB = faders[i].blue;
-            
-            faders[i].red = (uint8_t)(currentR + (originalColors[i][0] - currentR) * fadeProgress);
-            faders[i].green = (uint8_t)(currentG + (originalColors[i][1] - currentG) * fadeProgress);
-            faders[i].blue = (uint8_t)(currentB + (originalColors[i][2] - currentB) * fadeProgress);
-            
-            // Fade brightness to base
-            float brightnessFade = 1.0 - fadeProgress;
-            faders[i].currentBrightness = (uint8_t)(Fconfig.touchedBrightness * brightnessFade + 
-                                                   Fconfig.baseBrightness * fadeProgress);
-          } else {
-            // Completely finished - use original colors
-            faders[i].red = originalColors[i][0];
-            faders[i].green = originalColors[i][1];
-            faders[i].blue = originalColors[i][2];
-            faders[i].currentBrightness = Fconfig.baseBrightness;
-          }
-        }
-      } else {
-        // Haven't started yet
-        animationComplete = false;
-        faders[i].currentBrightness = 0;
-        faders[i].red = 0;
-        faders[i].green = 0;
-        faders[i].blue = 0;
-      }
-    }
-    
-    // Update the pixels with the calculated colors and brightness
-    for (int i = 0; i < NUM_FADERS; i++) {
-      uint32_t color = getScaledColor(faders[i]);
-      for (int j = 0; j < PIXELS_PER_FADER; j++) {
-        pixels.setPixelColor(i * PIXELS_PER_FADER + j, color);
-      }
-    }
-    pixels.show();
-    
-    delay(10);
-  }
-  
-  // Final cleanup - ensure all faders are properly reset
-  for (int i = 0; i < NUM_FADERS; i++) {
-    faders[i].currentBrightness = Fconfig.baseBrightness;
-    faders[i].red = originalColors[i][0];
-    faders[i].green = originalColors[i][1];
-    faders[i].blue = originalColors[i][2];
-  }
+  startStartupWave((uint16_t)STAGGER_DELAY, (uint16_t)COLOR_CYCLE_TIME);
 }
 
 void flashAllFadersRed() {
-  // Store original colors
-  uint8_t originalColors[NUM_FADERS][3];
-  for (int i = 0; i < NUM_FADERS; i++) {
-    originalColors[i][0] = faders[i].red;
-    originalColors[i][1] = faders[i].green;
-    originalColors[i][2] = faders[i].blue;
-  }
-  
-  // Flash 5 times
-  for (int flash = 0; flash < 5; flash++) {
-    // Set all to red
-    for (int i = 0; i < NUM_FADERS; i++) {
-      // Scale red by touchedBrightness
-      uint8_t scaledRed = (uint8_t)((255UL * Fconfig.touchedBrightness) / 255UL);
-      for (int j = 0; j < PIXELS_PER_FADER; j++) {
-        pixels.setPixelColor(i * PIXELS_PER_FADER + j, pixels.Color(scaledRed, 0, 0));
-      }
-    }
-    pixels.show();
-    delay(100);
-    
-    // Restore original colors and brightness via normal path
-    for (int i = 0; i < NUM_FADERS; i++) {
-      faders[i].red = originalColors[i][0];
-      faders[i].green = originalColors[i][1];
-      faders[i].blue = originalColors[i][2];
-    }
-    updateNeoPixels();
-    delay(100);
-  }
+  startFaderFlash(ALL_FADERS_MASK, pixels.Color(Fconfig.touchedBrightness, 0, 0), 5, 100, 100);
 }
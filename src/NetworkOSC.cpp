@@ -6,6 +6,9 @@
 #include "Config.h"
 #include "ExecutorStatus.h"
 #include "KeyLedControl.h"
+#include "OscTcp.h"
+#include "ConsoleLink.h"
+#include "PageCache.h"
 #include <AsyncUDP_Teensy41.h>
 #include <string.h>
 
@@ -23,13 +26,33 @@ bool faderColorDebug = false;
 //================================
 
 static constexpr size_t OSC_MAX_PACKET_SIZE = 1536;     // Max bytes we will accept per packet (covers worst-case color/int bundles with margin)
-static constexpr size_t OSC_QUEUE_DEPTH = 12;           // Number of packets buffered
-static constexpr uint8_t OSC_MAX_PACKETS_PER_LOOP = 4;  // Process this many packets per loop iteration
-static constexpr uint32_t OSC_PROCESS_BUDGET_US = 8000; // Stop processing if we exceed this budget in micro seconds
+static constexpr size_t OSC_QUEUE_DEPTH = 12;           // Number of control packets buffered (exec bundles, page changes)
+static constexpr uint8_t OSC_PACKETS_PER_LOOP = 4;      // Packets per loop iteration under normal load
+static constexpr uint8_t OSC_BURST_PACKETS_PER_LOOP = OSC_QUEUE_DEPTH; // Packets per loop while draining a backlog
+static constexpr uint32_t OSC_PROCESS_BUDGET_US = 8000; // Default processing budget per loop in micro seconds
+static constexpr uint32_t OSC_MIN_BUDGET_US = 2000;     // Never squeeze the budget below this
+static constexpr uint32_t OSC_MAX_BUDGET_US = 12000;    // Never let a single pass run longer than this
+static constexpr uint32_t OSC_LOOP_TARGET_US = 15000;   // Keep one loop() pass (OSC + motors + touch + LEDs) under this
+static constexpr uint32_t OSC_DROP_WINDOW_MS = 1000;    // Drops seen within this window keep the budget in burst mode
+static constexpr uint32_t OSC_COLOR_MAX_DEFER_US = 100000; // A pending color bundle older than this is handled ahead of control packets
+static constexpr uint8_t OSC_STATS_MAX_INTS = 32;       // Largest int reply sendOscInts() will build
+static constexpr int OSC_MAX_PAGE = 9999;               // Highest page number grandMA3 can send
+static constexpr size_t OSC_MAX_COLOR_STRING = 32;      // Longest color string accepted ("255;255;255;255" is 15)
+static constexpr uint32_t OSC_SOURCE_TIMEOUT_MS = 3000; // Active console silent this long -> switch to the other (plugin heartbeat is 1s)
+
+// Packets are sorted into lanes in the UDP callback. Control packets (fader setpoints,
+// executor status, page changes) keep FIFO order; color bundles always carry all 40
+// colors so only the newest one is kept and it is handled when the control lane is idle.
+enum OscLane : uint8_t {
+  OSC_LANE_CONTROL = 0,
+  OSC_LANE_COLOR
+};
 
 struct OscQueueItem {
   uint16_t len;
-  uint32_t arrivalMs;
+  uint32_t arrivalUs;       // micros() when the UDP callback saw the packet
+  IPAddress srcIP;          // Sender, used to answer /stats requests
+  uint16_t srcPort;
   uint8_t data[OSC_MAX_PACKET_SIZE];
 };
 
@@ -39,33 +62,95 @@ static volatile uint8_t oscQueueTail = 0;
 static volatile uint8_t oscQueueCount = 0;
 static volatile uint32_t oscQueueDrops = 0;
 static volatile uint32_t oscOversizeDrops = 0;
+static volatile uint32_t oscReceived = 0;         // Every packet the UDP callback saw
+static volatile uint8_t oscQueueHighWater = 0;    // Deepest the control lane has been
+
+static OscBudgetStats oscBudgetStats = {OSC_PROCESS_BUDGET_US, OSC_PACKETS_PER_LOOP, OSC_BUDGET_IDLE, 0, 0, {0}};
+
+static OscQueueItem oscColorSlot;                 // Newest color bundle waiting to be applied
+static volatile bool oscColorPending = false;
+static volatile uint32_t oscColorCoalesced = 0;   // Color bundles replaced by a newer one before being handled
+static uint32_t oscColorStale = 0;                // Color bundles dropped because they were for another page
+
+// Receive telemetry updated from the main loop (callback-side counters live above)
+static uint32_t oscHandledByType[OSC_MSG_TYPE_COUNT] = {0};
+static uint32_t oscParseFailures = 0;
+static uint32_t oscMalformed = 0;
+static uint32_t oscLatencyLastUs = 0;
+static uint32_t oscLatencyMaxUs = 0;
+static uint32_t oscLatencyHist[OSC_LATENCY_BUCKETS] = {0};
+
+// Upper bound of each latency bucket, the last bucket is open ended
+static constexpr uint32_t OSC_LATENCY_LIMITS_US[OSC_LATENCY_BUCKETS] = {250, 500, 1000, 2000, 5000, 10000, 20000, 0};
 
 // Forward declarations for async callbacks
 void handleBundledExecutorUpdate(LiteOSCParser& parser);
 void handleColorUpdate(LiteOSCParser& parser);
-static void handleOscPacket(const uint8_t* data, size_t len);
-static bool enqueueOscPacket(const uint8_t* data, size_t len);
+static void handleOscPacket(const OscQueueItem& pkt);
+static bool enqueueOscPacket(const uint8_t* data, size_t len, const IPAddress& srcIP, uint16_t srcPort);
 static bool dequeueOscPacket(OscQueueItem& out);
+static bool takeColorPacket(OscQueueItem& out);
+static void sendToDestinations(const uint8_t* buffer, size_t len);
 
 //================================
 // NETWORK SETUP
 //================================
 
-static bool enqueueOscPacket(const uint8_t* data, size_t len) {
+// Look at the address string only, so lane selection stays cheap inside the UDP callback
+static OscLane classifyOscPacket(const uint8_t* data, size_t len) {
+  static const char kColorAddress[] = "/colorUpdate";
+  const size_t needleLen = sizeof(kColorAddress) - 1;
+
+  const uint8_t* addrEnd = static_cast<const uint8_t*>(memchr(data, '\0', len));
+  if (addrEnd == nullptr) {
+    return OSC_LANE_CONTROL; // Not a valid address, let the parser reject it
+  }
+
+  const size_t addrLen = addrEnd - data;
+  for (size_t i = 0; i + needleLen <= addrLen; i++) {
+    if (memcmp(data + i, kColorAddress, needleLen) == 0) {
+      return OSC_LANE_COLOR;
+    }
+  }
+  return OSC_LANE_CONTROL;
+}
+
+static bool enqueueOscPacket(const uint8_t* data, size_t len, const IPAddress& srcIP, uint16_t srcPort) {
+  oscReceived++;
   if (len > OSC_MAX_PACKET_SIZE) {
     oscOversizeDrops++;
     return false;
   }
 
+  if (classifyOscPacket(data, len) == OSC_LANE_COLOR) {
+    noInterrupts();
+    if (oscColorPending) {
+      oscColorCoalesced++;
+    }
+    oscColorSlot.len = static_cast<uint16_t>(len);
+    oscColorSlot.arrivalUs = micros();
+    oscColorSlot.srcIP = srcIP;
+    oscColorSlot.srcPort = srcPort;
+    memcpy(oscColorSlot.data, data, len);
+    oscColorPending = true;
+    interrupts();
+    return true;
+  }
+
   bool queued = false;
   noInterrupts();
   if (oscQueueCount < OSC_QUEUE_DEPTH) {
     OscQueueItem& slot = oscQueue[oscQueueHead];
     slot.len = static_cast<uint16_t>(len);
-    slot.arrivalMs = millis();
+    slot.arrivalUs = micros();
+    slot.srcIP = srcIP;
+    slot.srcPort = srcPort;
     memcpy(slot.data, data, len);
     oscQueueHead = (oscQueueHead + 1) % OSC_QUEUE_DEPTH;
     oscQueueCount++;
+    if (oscQueueCount > oscQueueHighWater) {
+      oscQueueHighWater = oscQueueCount;
+    }
     queued = true;
   } else {
     oscQueueDrops++;
@@ -74,6 +159,11 @@ static bool enqueueOscPacket(const uint8_t* data, size_t len) {
   return queued;
 }
 
+// Packets from the TCP transport share the queue, lanes and statistics with UDP
+bool queueIncomingOsc(const uint8_t* data, size_t len, const IPAddress& srcIP, uint16_t srcPort) {
+  return enqueueOscPacket(data, len, srcIP, srcPort);
+}
+
 static bool dequeueOscPacket(OscQueueItem& out) {
   bool hasPacket = false;
   noInterrupts();
@@ -87,12 +177,83 @@ static bool dequeueOscPacket(OscQueueItem& out) {
   return hasPacket;
 }
 
+static bool takeColorPacket(OscQueueItem& out) {
+  bool hasPacket = false;
+  noInterrupts();
+  if (oscColorPending) {
+    out = oscColorSlot;
+    oscColorPending = false;
+    hasPacket = true;
+  }
+  interrupts();
+  return hasPacket;
+}
+
+// A page change on the control lane makes a waiting color bundle suspect: drop it. Its update
+// number is never noted, so the next heartbeat asks the plugin for the colors again.
+static void discardPendingColor() {
+  noInterrupts();
+  if (oscColorPending) {
+    oscColorPending = false;
+    oscColorStale++;
+  }
+  interrupts();
+}
+
+static bool colorPacketOverdue() {
+  bool overdue = false;
+  noInterrupts();
+  overdue = oscColorPending && (micros() - oscColorSlot.arrivalUs >= OSC_COLOR_MAX_DEFER_US);
+  interrupts();
+  return overdue;
+}
+
+//================================
+// MULTICAST GROUP
+//================================
+
+// The listener is bound to any address, so once the interface has joined the group
+// packets sent to multicastIP:receivePort arrive through the same callback and queue.
+static IPAddress joinedGroup;
+static bool groupJoined = false;
+
+bool isMulticastAddress(const IPAddress& ip) {
+  return ip[0] >= 224 && ip[0] <= 239;
+}
+
+// Join, leave or switch the OSC multicast group to match netConfig
+void updateMulticastMembership() {
+  if (groupJoined && (!netConfig.useMulticast || joinedGroup != netConfig.multicastIP)) {
+    Ethernet.leaveGroup(joinedGroup);
+    groupJoined = false;
+    debugPrintf("Left multicast group %u.%u.%u.%u\n", joinedGroup[0], joinedGroup[1], joinedGroup[2], joinedGroup[3]);
+  }
+
+  if (!netConfig.useMulticast || groupJoined) {
+    return;
+  }
+
+  const IPAddress& group = netConfig.multicastIP;
+  if (!isMulticastAddress(group)) {
+    debugPrintf("Multicast IP %u.%u.%u.%u is not a multicast address\n", group[0], group[1], group[2], group[3]);
+    return;
+  }
+
+  if (Ethernet.joinGroup(group)) {
+    joinedGroup = group;
+    groupJoined = true;
+    debugPrintf("Joined multicast group %u.%u.%u.%u\n", group[0], group[1], group[2], group[3]);
+  } else {
+    debugPrint("Failed to join multicast group");
+  }
+}
+
 static void attachUdpHandler() {
   oscUdp.onPacket([](AsyncUDPPacket &packet) {
     const uint8_t* data = packet.data();
     const size_t len = packet.length();
 
-    if (!enqueueOscPacket(data, len)) {
+    if (!enqueueOscPacket(data, len, packet.remoteIP(), packet.remotePort())) {
       static uint32_t lastDropPrint = 0;
       const uint32_t now = millis();
       if (now - lastDropPrint > 500) { // rate-limit debug spam
@@ -107,42 +268,129 @@ static void attachUdpHandler() {
   });
 }
 
+//================================
+// NETWORK BRING-UP
+//================================
+
+// Link and DHCP run in the background so faders, touch and keys work from the first loop.
+// The QNEthernet callbacks only raise flags; networkLoop() does the work.
+enum NetBringUpState : uint8_t {
+  NET_DHCP_WAIT = 0,     // DHCP running, no lease yet
+  NET_DHCP_READY,
+  NET_STATIC,            // Configured for static IP
+  NET_STATIC_FALLBACK    // DHCP timed out, static until the link comes back
+};
+
+static uint8_t netState = NET_DHCP_WAIT;
+static uint32_t dhcpStartMs = 0;
+static volatile bool linkChanged = false;
+static volatile bool addressChanged = false;
+static bool networkCallbacksSet = false;
+static bool mdnsStarted = false;
+
+static void startDhcp() {
+  Ethernet.begin();
+  netState = NET_DHCP_WAIT;
+  dhcpStartMs = millis();
+}
+
+static void startStatic(uint8_t state) {
+  Ethernet.begin(netConfig.staticIP, netConfig.subnet, netConfig.gateway);
+  netState = state;
+}
+
+bool networkReady() {
+  return Ethernet.linkState() && Ethernet.localIP() != IPAddress(0, 0, 0, 0);
+}
+
 void setupNetwork() {
   debugPrint("Setting up network...");
-  
-  delay(100); //make sure we see network debug message before looking for dhcp so we know we are booting up
 
   Ethernet.setHostname(kServiceName);
 
-  // Start Ethernet with configured settings
+  if (!networkCallbacksSet) {
+    Ethernet.onLinkState([](bool) { linkChanged = true; });
+    Ethernet.onAddressChanged([]() { addressChanged = true; });
+    networkCallbacksSet = true;
+  }
+
+  // Start Ethernet with configured settings, the address arrives later through networkLoop()
   if (netConfig.useDHCP) {
-    debugPrint("Using DHCP...");
-    if (!Ethernet.begin() || !Ethernet.waitForLocalIP(kDHCPTimeout)) {
-      debugPrint("Failed DHCP, switching to static IP");
-      Ethernet.begin(netConfig.staticIP, netConfig.subnet, netConfig.gateway);
-    }
+    debugPrint("Using DHCP (background)...");
+    startDhcp();
   } else {
     debugPrint("Using static IP...");
-    Ethernet.begin(netConfig.staticIP, netConfig.subnet, netConfig.gateway);
+    startStatic(NET_STATIC);
   }
 
-  IPAddress ip = Ethernet.localIP();
-  debugPrintf("IP Address: %u.%u.%u.%u\n", ip[0], ip[1], ip[2], ip[3]);
-
-  // Set up mDNS for service discovery
-  MDNS.begin(kServiceName);
-  MDNS.addService("_osc", "_udp", netConfig.receivePort);
-
-  // Start AsyncUDP listener
+  // Start AsyncUDP listener (bound to any address, so it works before we have one)
   if (oscUdp.listen(netConfig.receivePort)) {
     attachUdpHandler();
     debugPrintf("AsyncUDP listening on port %d\n", netConfig.receivePort);
   } else {
     debugPrint("Failed to start AsyncUDP listener");
   }
+
+  groupJoined = false; // Memberships do not survive Ethernet.end()
+  updateMulticastMembership();
   debugPrint("OSC and mDNS initialized");
 }
 
+void networkLoop() {
+  if (linkChanged) {
+    linkChanged = false;
+    const bool up = Ethernet.linkState();
+    debugPrintf("[NET] Link %s\n", up ? "up" : "down");
+    if (up && netState == NET_STATIC_FALLBACK) {
+      debugPrint("[NET] Retrying DHCP");
+      startDhcp();
+    } else if (up && netState == NET_DHCP_WAIT) {
+      dhcpStartMs = millis(); // A server cannot answer before the cable is in
+    }
+  }
+
+  if (netState == NET_DHCP_WAIT && Ethernet.linkState() && millis() - dhcpStartMs > kDHCPTimeout) {
+    debugPrint("Failed DHCP, switching to static IP");
+    startStatic(NET_STATIC_FALLBACK);
+  }
+
+  if (addressChanged) {
+    addressChanged = false;
+    const IPAddress ip = Ethernet.localIP();
+    debugPrintf("IP Address: %u.%u.%u.%u\n", ip[0], ip[1], ip[2], ip[3]);
+
+    if (ip != IPAddress(0, 0, 0, 0)) {
+      if (netState == NET_DHCP_WAIT) {
+        netState = NET_DHCP_READY;
+      }
+
+      // Set up mDNS for service discovery, re-announce on later changes
+      if (!mdnsStarted) {
+        MDNS.begin(kServiceName);
+        MDNS.addService("_osc", "_udp", netConfig.receivePort);
+        mdnsStarted = true;
+      } else {
+        MDNS.restart();
+      }
+
+      groupJoined = false;
+      updateMulticastMembership();
+    }
+
+    displayIPAddress();
+  }
+}
+
+const char* networkStateName() {
+  switch (netState) {
+    case NET_DHCP_WAIT: return "waiting for DHCP";
+    case NET_DHCP_READY: return "DHCP";
+    case NET_STATIC: return "static";
+    case NET_STATIC_FALLBACK: return "static (DHCP failed)";
+    default: return "?";
+  }
+}
+
 // Restart UDP after changes to network settings
 void restartUDP() {
   debugPrint("Restarting UDP service...");
@@ -157,6 +405,8 @@ void restartUDP() {
     debugPrint("Failed to restart UDP.");
   }
 
+  updateMulticastMembership();
+
   // Re-register mDNS if needed
   MDNS.addService("_osc", "_udp", netConfig.receivePort);
 }
@@ -167,10 +417,17 @@ void restartUDP() {
 //OSC MESSAGE HANDLING
 //================================
 
-static void handleOscPacket(const uint8_t* data, size_t len) {
+static void sendOscStatsReply(const IPAddress& ip, uint16_t port);
+
+static bool validOscPage(int page) {
+  return page >= 1 && page <= OSC_MAX_PAGE;
+}
+
+static void handleOscPacket(const OscQueueItem& pkt) {
   LiteOSCParser parser;
 
-  if (!parser.parse(data, len)) {
+  if (!parser.parse(pkt.data, pkt.len)) {
+    oscParseFailures++;
     debugPrint("Invalid OSC message.");
     return;
   }
@@ -178,34 +435,357 @@ static void handleOscPacket(const uint8_t* data, size_t len) {
   const char* addr = parser.getAddress();
 
   if (strstr(addr, "/execUpdate") != NULL) {
+    oscHandledByType[OSC_MSG_EXEC]++;
     handleBundledExecutorUpdate(parser);
   } else if (strstr(addr, "/colorUpdate") != NULL) {
+    oscHandledByType[OSC_MSG_COLOR]++;
     handleColorUpdate(parser);
   } else if (strstr(addr, "/updatePage/current") != NULL) {
-    if (parser.getTag(0) == 'i') {
+    oscHandledByType[OSC_MSG_PAGE]++;
+    if (parser.getTag(0) == 'i' && validOscPage(parser.getInt(0))) {
       handlePageUpdate(addr, parser.getInt(0));
+    } else {
+      oscMalformed++;
+    }
+  } else if (strcmp(addr, "/stats") == 0) {
+    oscHandledByType[OSC_MSG_STATS]++;
+    sendOscStatsReply(pkt.srcIP, pkt.srcPort);
+  } else if (strcmp(addr, "/heartbeat") == 0) {
+    oscHandledByType[OSC_MSG_OTHER]++;
+    // Plugins before update numbering send only the heartbeat count
+    if (parser.getArgCount() >= 3 && parser.getTag(1) == 'i' && parser.getTag(2) == 'i') {
+      handleConsoleHeartbeat(parser.getInt(1), parser.getInt(2));
+    }
+  } else if (strcmp(addr, "/pong") == 0) {
+    oscHandledByType[OSC_MSG_OTHER]++;
+    if (parser.getTag(0) == 'i' && parser.getTag(1) == 'i' && parser.getTag(2) == 'i') {
+      handleConsolePong(parser.getInt(0), parser.getInt(1), parser.getInt(2));
+    } else {
+      oscMalformed++;
+    }
+  } else {
+    oscHandledByType[OSC_MSG_OTHER]++;
+  }
+}
+
+//================================
+// RECEIVE TELEMETRY
+//================================
+
+static void recordOscLatency(uint32_t arrivalUs) {
+  const uint32_t latency = micros() - arrivalUs;
+  oscLatencyLastUs = latency;
+  if (latency > oscLatencyMaxUs) {
+    oscLatencyMaxUs = latency;
+  }
+
+  uint8_t bucket = 0;
+  while (bucket < OSC_LATENCY_BUCKETS - 1 && latency > OSC_LATENCY_LIMITS_US[bucket]) {
+    bucket++;
+  }
+  oscLatencyHist[bucket]++;
+}
+
+void getOscRxStats(OscRxStats& out) {
+  noInterrupts();
+  out.received = oscReceived;
+  out.queueDrops = oscQueueDrops;
+  out.oversizeDrops = oscOversizeDrops;
+  out.colorCoalesced = oscColorCoalesced;
+  out.colorStale = oscColorStale;
+  out.queueHighWater = oscQueueHighWater;
+  interrupts();
+
+  for (uint8_t t = 0; t < OSC_MSG_TYPE_COUNT; t++) {
+    out.handled[t] = oscHandledByType[t];
+  }
+  out.parseFailures = oscParseFailures;
+  out.malformed = oscMalformed;
+  out.latencyLastUs = oscLatencyLastUs;
+  out.latencyMaxUs = oscLatencyMaxUs;
+  for (uint8_t b = 0; b < OSC_LATENCY_BUCKETS; b++) {
+    out.latencyHist[b] = oscLatencyHist[b];
+  }
+}
+
+uint32_t oscLatencyBucketLimitUs(uint8_t bucket) {
+  return (bucket < OSC_LATENCY_BUCKETS) ? OSC_LATENCY_LIMITS_US[bucket] : 0;
+}
+
+const char* oscMsgTypeName(uint8_t type) {
+  switch (type) {
+    case OSC_MSG_EXEC:  return "exec";
+    case OSC_MSG_COLOR: return "color";
+    case OSC_MSG_PAGE:  return "page";
+    case OSC_MSG_STATS: return "stats";
+    case OSC_MSG_OTHER: return "other";
+    default:            return "unknown";
+  }
+}
+
+// Answer "/stats" with "/stats/rx" and a fixed list of ints:
+// received, exec, color, page, stats, other, queueDrops, oversize, coalesced,
+// parseFailures, malformed, highWater, latencyLastUs, latencyMaxUs, then the histogram buckets
+static void sendOscStatsReply(const IPAddress& ip, uint16_t port) {
+  OscRxStats stats;
+  getOscRxStats(stats);
+
+  int32_t values[OSC_STATS_MAX_INTS];
+  uint8_t n = 0;
+  values[n++] = stats.received;
+  for (uint8_t t = 0; t < OSC_MSG_TYPE_COUNT; t++) {
+    values[n++] = stats.handled[t];
+  }
+  values[n++] = stats.queueDrops;
+  values[n++] = stats.oversizeDrops;
+  values[n++] = stats.colorCoalesced;
+  values[n++] = stats.parseFailures;
+  values[n++] = stats.malformed;
+  values[n++] = stats.queueHighWater;
+  values[n++] = stats.latencyLastUs;
+  values[n++] = stats.latencyMaxUs;
+  for (uint8_t b = 0; b < OSC_LATENCY_BUCKETS; b++) {
+    values[n++] = stats.latencyHist[b];
+  }
+
+  sendOscInts("/stats/rx", values, n, ip, port);
+}
+
+//================================
+// OSC DESTINATIONS AND FAILOVER
+//================================
+
+// Slot 0 is the primary console (sendToIP), slot 1 the backup (backupIP). Output goes to
+// every enabled slot; input is only applied from the active one so two consoles never fight.
+static OscDestination oscDestinations[OSC_MAX_DESTINATIONS];
+static uint8_t oscActiveSource = OSC_DEST_PRIMARY;
+static uint32_t oscFailovers = 0;
+
+static void refreshDestinationAddresses() {
+  OscDestination& primary = oscDestinations[OSC_DEST_PRIMARY];
+  OscDestination& backup = oscDestinations[OSC_DEST_BACKUP];
+
+  primary.enabled = true;
+  backup.enabled = netConfig.useBackup && isValidDestination(netConfig.backupIP);
+
+  if (primary.ip != netConfig.sendToIP) {
+    primary = OscDestination{};
+    primary.ip = netConfig.sendToIP;
+    primary.enabled = true;
+  }
+  if (backup.ip != netConfig.backupIP) {
+    const bool enabled = backup.enabled;
+    backup = OscDestination{};
+    backup.ip = netConfig.backupIP;
+    backup.enabled = enabled;
+  }
+  if (!backup.enabled) {
+    oscActiveSource = OSC_DEST_PRIMARY;
+  }
+}
+
+bool isValidDestination(const IPAddress& ip) {
+  return ip[0] != 0 && ip[0] != 255 && !isMulticastAddress(ip);
+}
+
+static bool heardRecently(const OscDestination& dest, uint32_t now) {
+  return dest.heard && (now - dest.lastHeardMs < OSC_SOURCE_TIMEOUT_MS);
+}
+
+// Switch sync source when the active console has gone quiet and the other one is talking
+static void updateSyncSource() {
+  const OscDestination& backup = oscDestinations[OSC_DEST_BACKUP];
+  if (!backup.enabled) {
+    return;
+  }
+
+  const uint32_t now = millis();
+  const uint8_t other = (oscActiveSource == OSC_DEST_PRIMARY) ? OSC_DEST_BACKUP : OSC_DEST_PRIMARY;
+  if (!heardRecently(oscDestinations[oscActiveSource], now) && heardRecently(oscDestinations[other], now)) {
+    oscActiveSource = other;
+    oscFailovers++;
+    invalidateColorCache();
+    requestConsoleResync(RESYNC_FAILOVER); // The new console's state may differ from what we hold
+    const IPAddress& ip = oscDestinations[other].ip;
+    debugPrintf("[OSC] Sync source now %s console %u.%u.%u.%u\n",
+                other == OSC_DEST_PRIMARY ? "primary" : "backup", ip[0], ip[1], ip[2], ip[3]);
+  }
+}
+
+// Record traffic from a console and decide whether its packet should be applied
+static bool acceptFromSource(const IPAddress& src) {
+  for (uint8_t i = 0; i < OSC_MAX_DESTINATIONS; i++) {
+    OscDestination& dest = oscDestinations[i];
+    if (!dest.enabled || dest.ip != src) {
+      continue;
     }
+    dest.received++;
+    dest.lastHeardMs = millis();
+    dest.heard = true;
+
+    if (i != oscActiveSource) {
+      updateSyncSource(); // The active console may have timed out just now
+    }
+    if (i != oscActiveSource) {
+      dest.ignored++;
+      return false;
+    }
+    return true;
+  }
+  return true; // Not a console (tools, /stats requests)
+}
+
+const OscDestination& getOscDestination(uint8_t index) {
+  return oscDestinations[index < OSC_MAX_DESTINATIONS ? index : 0];
+}
+
+uint8_t getOscActiveSource() {
+  return oscActiveSource;
+}
+
+uint32_t getOscFailoverCount() {
+  return oscFailovers;
+}
+
+//================================
+// ADAPTIVE PROCESSING BUDGET
+//================================
+
+// Time the rest of loop() takes between two OSC passes, smoothed so one slow web request does not swing the budget
+static uint32_t oscLastPassEndUs = 0;
+static uint32_t oscSmoothedOtherUs = 0;
+static constexpr uint32_t OSC_OTHER_SAMPLE_CAP_US = 50000;
+
+static void trackLoopTiming(uint32_t passStartUs) {
+  if (oscLastPassEndUs != 0) {
+    uint32_t sample = passStartUs - oscLastPassEndUs;
+    if (sample > OSC_OTHER_SAMPLE_CAP_US) sample = OSC_OTHER_SAMPLE_CAP_US;
+    // EWMA with 1/8 weight for the new sample
+    oscSmoothedOtherUs = oscSmoothedOtherUs - (oscSmoothedOtherUs >> 3) + (sample >> 3);
+  }
+  oscBudgetStats.loopOtherUs = oscSmoothedOtherUs;
+}
+
+// Whatever is left of the loop target after the other stages, within the hard limits
+static uint32_t loopHeadroomUs() {
+  uint32_t headroom = (oscSmoothedOtherUs < OSC_LOOP_TARGET_US) ? OSC_LOOP_TARGET_US - oscSmoothedOtherUs : 0;
+  return constrain(headroom, OSC_MIN_BUDGET_US, OSC_MAX_BUDGET_US);
+}
+
+// Pick this loop's packet cap and time budget from queue depth, recent drops and loop timing
+static void chooseOscBudget(uint32_t& budgetUs, uint8_t& packetLimit) {
+  static uint32_t lastDropTotal = 0;
+  static uint32_t lastDropSeenMs = 0;
+
+  uint8_t depth = 0;
+  uint32_t dropTotal = 0;
+  bool colorPending = false;
+  noInterrupts();
+  depth = oscQueueCount;
+  dropTotal = oscQueueDrops;
+  colorPending = oscColorPending;
+  interrupts();
+
+  const uint32_t now = millis();
+  if (dropTotal != lastDropTotal) {
+    lastDropTotal = dropTotal;
+    lastDropSeenMs = now;
+  }
+  const bool recentDrops = (lastDropSeenMs != 0) && (now - lastDropSeenMs < OSC_DROP_WINDOW_MS);
+
+  OscBudgetReason reason;
+  if (recentDrops) {
+    // Already losing packets: drain everything the loop target allows
+    reason = OSC_BUDGET_DROPS;
+    packetLimit = OSC_BURST_PACKETS_PER_LOOP;
+    budgetUs = loopHeadroomUs();
+  } else if (depth >= OSC_QUEUE_DEPTH / 2) {
+    // Backlog building: take as many as are waiting, bounded by headroom
+    reason = OSC_BUDGET_BACKLOG;
+    packetLimit = max(depth, OSC_PACKETS_PER_LOOP);
+    budgetUs = loopHeadroomUs();
+  } else if (depth == 0 && !colorPending) {
+    reason = OSC_BUDGET_IDLE;
+    packetLimit = OSC_PACKETS_PER_LOOP;
+    budgetUs = OSC_PROCESS_BUDGET_US;
+  } else {
+    reason = OSC_BUDGET_STEADY;
+    packetLimit = OSC_PACKETS_PER_LOOP;
+    budgetUs = OSC_PROCESS_BUDGET_US;
+  }
+
+  // The other stages are already eating the loop target: give back time so motors and touch keep their rate
+  if (reason != OSC_BUDGET_DROPS && budgetUs > loopHeadroomUs()) {
+    budgetUs = loopHeadroomUs();
+    reason = OSC_BUDGET_LOOP_PRESSURE;
+  }
+
+  oscBudgetStats.budgetUs = budgetUs;
+  oscBudgetStats.packetLimit = packetLimit;
+  oscBudgetStats.lastReason = reason;
+  oscBudgetStats.decisions[reason]++;
+}
+
+const OscBudgetStats& getOscBudgetStats() {
+  return oscBudgetStats;
+}
+
+const char* oscBudgetReasonName(uint8_t reason) {
+  switch (reason) {
+    case OSC_BUDGET_IDLE:          return "idle";
+    case OSC_BUDGET_STEADY:        return "steady";
+    case OSC_BUDGET_BACKLOG:       return "backlog";
+    case OSC_BUDGET_DROPS:         return "drops";
+    case OSC_BUDGET_LOOP_PRESSURE: return "loop_pressure";
+    default:                       return "unknown";
   }
 }
 
+static void handleQueuedPacket(const OscQueueItem& pkt) {
+  if (acceptFromSource(pkt.srcIP)) {
+    handleOscPacket(pkt);
+  }
+  recordOscLatency(pkt.arrivalUs);
+}
+
 // Pull queued packets from the UDP callback and process a few each loop.
+// Control packets go first; the pending color bundle gets whatever budget is left,
+// unless it has been waiting long enough that it jumps the line.
 void processOscQueue() {
+  const uint32_t passStartUs = micros();
+  trackLoopTiming(passStartUs);
+
+  uint32_t budgetUs = OSC_PROCESS_BUDGET_US;
+  uint8_t packetLimit = OSC_PACKETS_PER_LOOP;
+  chooseOscBudget(budgetUs, packetLimit);
+
+  refreshDestinationAddresses();
+  updateSyncSource();
+
   uint8_t processed = 0;
   elapsedMicros budget;
   OscQueueItem pkt{};
 
-  while (processed < OSC_MAX_PACKETS_PER_LOOP && dequeueOscPacket(pkt)) {
-    handleOscPacket(pkt.data, pkt.len);
+  if (colorPacketOverdue() && takeColorPacket(pkt)) {
+    handleQueuedPacket(pkt);
     processed++;
+  }
 
-    if (budget >= OSC_PROCESS_BUDGET_US) {
-      break;
-    }
+  while (processed < packetLimit && budget < budgetUs && dequeueOscPacket(pkt)) {
+    handleQueuedPacket(pkt);
+    processed++;
+  }
+
+  if (processed < packetLimit && budget < budgetUs && takeColorPacket(pkt)) {
+    handleQueuedPacket(pkt);
+    processed++;
   }
 
   static uint32_t lastDropLog = 0;
+  static uint32_t loggedDrops = 0;
+  static uint32_t loggedOversize = 0;
   const uint32_t now = millis();
-  if ((oscQueueDrops || oscOversizeDrops) && (now - lastDropLog > 1000)) {
+  if ((oscQueueDrops != loggedDrops || oscOversizeDrops != loggedOversize) && (now - lastDropLog > 1000)) {
     uint32_t drops = 0;
     uint32_t oversize = 0;
     uint8_t depth = 0;
@@ -214,13 +794,18 @@ void processOscQueue() {
     drops = oscQueueDrops;
     oversize = oscOversizeDrops;
     depth = oscQueueCount;
-    oscQueueDrops = 0;
-    oscOversizeDrops = 0;
     interrupts();
 
-    debugPrintf("[OSC] queue drops=%lu oversize=%lu depth=%u", drops, oversize, depth);
+    debugPrintf("[OSC] queue drops=%lu oversize=%lu depth=%u budget=%luus (%s)",
+                drops - loggedDrops, oversize - loggedOversize, depth,
+                oscBudgetStats.budgetUs, oscBudgetReasonName(oscBudgetStats.lastReason));
+    loggedDrops = drops;
+    loggedOversize = oversize;
     lastDropLog = now;
   }
+
+  oscLastPassEndUs = micros();
+  oscBudgetStats.oscStageUs = oscLastPassEndUs - passStartUs;
 }
 
 // Page update message handling
@@ -228,37 +813,90 @@ void handlePageUpdate(const char *address, int value) {
   if (strstr(address, "/updatePage/current") != NULL) {
     if (value != currentOSCPage) {
       debugPrintf("Page changed from %d to %d (via updatePage command)\n", currentOSCPage, value);
+      currentOSCPage = value;
+      discardPendingColor();
+      // Start moving from what we last saw on this page; the console's bundles follow
+      pageCacheApply(value);
     }
-    currentOSCPage = value;
   }
 }
 
 
-static bool parseSimpleColorString(const char* colorString, uint8_t& r, uint8_t& g, uint8_t& b) {
-  if (!colorString) return false;
+//================================
+// COLOR STRING PARSING
+//================================
 
-  char buffer[64];
-  strncpy(buffer, colorString, sizeof(buffer) - 1);
-  buffer[sizeof(buffer) - 1] = '\0';
+static constexpr uint8_t COLOR_CACHE_LEN = 20; // "255;255;255;255" plus margin, longer strings are never cached
 
-  char* token = strtok(buffer, ",;");
-  if (!token) return false;
-  r = constrain(atoi(token), 0, 255);
+// Raw color string last applied to each executor, so unchanged colors skip parsing entirely
+static char lastColorStrings[NUM_EXECUTORS_TRACKED][COLOR_CACHE_LEN];
 
-  token = strtok(nullptr, ",;");
-  if (!token) return false;
-  g = constrain(atoi(token), 0, 255);
+// Reads one component the way atoi() + constrain(0..255) did and leaves p on the next separator
+static bool readColorComponent(const char*& p, uint8_t& out) {
+  while (*p == ',' || *p == ';') p++; // strtok skipped empty tokens
+  if (*p == '\0') return false;
 
-  token = strtok(nullptr, ",;");
-  if (!token) return false;
-  b = constrain(atoi(token), 0, 255);
+  while (*p == ' ') p++;
+  bool negative = false;
+  if (*p == '-' || *p == '+') {
+    negative = (*p == '-');
+    p++;
+  }
 
+  uint16_t value = 0;
+  while (*p >= '0' && *p <= '9') {
+    if (value <= 255) value = value * 10 + (*p - '0');
+    p++;
+  }
+  out = negative ? 0 : (value > 255 ? 255 : value);
+
+  while (*p != '\0' && *p != ',' && *p != ';') p++; // ignore the rest of the token
   return true;
 }
 
-static void applyColorToExecutor(int oscId, const char* colorString) {
+// Single pass over "r;g;b[;a]" (',' also accepted), no copies
+static bool parseSimpleColorString(const char* colorString, uint8_t& r, uint8_t& g, uint8_t& b) {
+  if (!colorString) return false;
+
+  const char* p = colorString;
+  return readColorComponent(p, r) && readColorComponent(p, g) && readColorComponent(p, b);
+}
+
+// True if the string matches what was last applied; otherwise remembers it (when it fits)
+static bool colorStringUnchanged(int execIndex, const char* colorString) {
+  char* cached = lastColorStrings[execIndex];
+  uint8_t i = 0;
+  while (i < COLOR_CACHE_LEN && cached[i] == colorString[i]) {
+    if (colorString[i] == '\0') return true;
+    i++;
+  }
+
+  // Differs: store the new string, or clear the slot if it is too long to cache
+  uint8_t len = 0;
+  while (len < COLOR_CACHE_LEN && colorString[len] != '\0') len++;
+  if (len < COLOR_CACHE_LEN) {
+    memcpy(cached, colorString, len + 1);
+  } else {
+    cached[0] = '\0';
+  }
+  return false;
+}
+
+// Forget the cached strings so the next color bundle is applied in full
+void invalidateColorCache() {
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+    lastColorStrings[i][0] = '\0';
+  }
+}
+
+static void applyColorToExecutor(int execIndex, int oscId, const char* colorString) {
+  if (!colorString || colorStringUnchanged(execIndex, colorString)) {
+    return;
+  }
+
   uint8_t r, g, b;
   if (!parseSimpleColorString(colorString, r, g, b)) {
+    lastColorStrings[execIndex][0] = '\0';
     return;
   }
 
@@ -284,24 +922,39 @@ void handleBundledExecutorUpdate(LiteOSCParser& parser) {
   const int expectedArgs = 1 + 10 + NUM_EXECUTORS_TRACKED;
 
   if (parser.getArgCount() < expectedArgs) {
+    oscMalformed++;
     debugPrint("Invalid exec bundle - not enough arguments");
     return;
   }
 
   if (parser.getTag(0) != 'i') {
+    oscMalformed++;
     debugPrint("Invalid exec bundle - page not integer");
     return;
   }
 
   int pageNum = parser.getInt(0);
+  if (!validOscPage(pageNum)) {
+    oscMalformed++;
+    debugPrintf("Invalid exec bundle - page %d out of range\n", pageNum);
+    return;
+  }
+
+  // Optional trailing update number from the plugin
+  if (parser.getArgCount() > expectedArgs && parser.getTag(expectedArgs) == 'i') {
+    noteConsoleUpdateSeq(CONSOLE_STREAM_EXEC, parser.getInt(expectedArgs));
+  }
+
   if (pageNum != currentOSCPage) {
     debugPrintf("Page changed from %d to %d (via exec bundle)\n", currentOSCPage, pageNum);
     currentOSCPage = pageNum;
+    discardPendingColor();
   }
 
-  bool stateChanged = false;
   bool needToMoveFaders = false;
   bool blockFaderUpdates = calibrationInProgress;
+  int badArgs = 0;  // Reported once per bundle so a broken sender cannot flood the serial port
+  uint8_t consoleSetpoints[10];  // As sent, for the page cache
 
   // Fader values (201-210) occupy args 1-10
   for (int i = 0; i < 10; i++) {
@@ -309,19 +962,20 @@ void handleBundledExecutorUpdate(LiteOSCParser& parser) {
     int faderOscID = 201 + i;
 
     if (parser.getTag(argIndex) != 'i') {
-      debugPrintf("Invalid fader value type for fader %d\n", faderOscID);
+      badArgs++;
       continue;
     }
 
-    int oscValue = parser.getInt(argIndex);
+    int oscValue = constrain(parser.getInt(argIndex), 0, 100);
     int faderIndex = getFaderIndexFromID(faderOscID);
+    consoleSetpoints[i] = oscValue;
 
     if (blockFaderUpdates) {
       continue;
     }
 
     if (faderIndex >= 0 && faderIndex < NUM_FADERS) {
-      if (!faders[faderIndex].touched) {
+      if (!faders[faderIndex].touched && !isStaleFaderEcho(faders[faderIndex], pageNum, oscValue)) {
         int currentOscvalue = readFadertoOSC(faders[faderIndex]);
         if (abs(oscValue - currentOscvalue) > Fconfig.targetTolerance) {
           debugPrintf("Updating fader %d setpoint: %d -> %d\n", faderOscID, currentOscvalue, oscValue);
@@ -338,24 +992,29 @@ void handleBundledExecutorUpdate(LiteOSCParser& parser) {
   for (int i = 0; i < NUM_EXECUTORS_TRACKED; ++i) {
     int argIndex = 11 + i;
     if (parser.getTag(argIndex) != 'i') {
-      debugPrintf("Invalid exec status type for executor %d\n", EXECUTOR_IDS[i]);
+      badArgs++;
       continue;
     }
 
     int raw = parser.getInt(argIndex);
     uint8_t status = raw < 0 ? 0 : (raw > 2 ? 2 : raw); // 0=empty,1=off,2=on
-    if (setExecutorStateByIndex(i, status)) {
-      stateChanged = true;
-    }
+    setExecutorStateByIndex(i, status);   // Marks the key's LEDs if it changed
   }
 
-  if (stateChanged) {
-    markKeyLedsDirty();
+  if (badArgs > 0) {
+    oscMalformed++;
+    debugPrintf("Exec bundle had %d arguments of the wrong type\n", badArgs);
+  } else {
+    pageCacheStoreExec(pageNum, consoleSetpoints);
   }
 
   if (needToMoveFaders) {
-    debugPrint("Moving faders to new setpoints");
-    moveAllFadersToSetpoints();
+    if (consoleLinkAllowsMotion()) {
+      debugPrint("Moving faders to new setpoints");
+      moveAllFadersToSetpoints();
+    } else {
+      debugPrint("Console link lost, holding faders until resync");
+    }
   }
 }
 
@@ -364,28 +1023,53 @@ void handleColorUpdate(LiteOSCParser& parser) {
   const int expectedArgs = 1 + NUM_EXECUTORS_TRACKED;
 
   if (parser.getArgCount() < expectedArgs) {
+    oscMalformed++;
     debugPrint("Invalid color bundle - not enough arguments");
     return;
   }
 
   if (parser.getTag(0) != 'i') {
+    oscMalformed++;
     debugPrint("Invalid color bundle - page not integer");
     return;
   }
 
   int pageNum = parser.getInt(0);
+  if (!validOscPage(pageNum)) {
+    oscMalformed++;
+    debugPrintf("Invalid color bundle - page %d out of range\n", pageNum);
+    return;
+  }
+
+  // The color lane runs behind the control lane, so it never changes the page. A bundle for
+  // another page is dropped before its update number is noted; if it was the newest, the
+  // heartbeat check requests a resync.
   if (pageNum != currentOSCPage) {
-    debugPrintf("Page changed from %d to %d (via color bundle)\n", currentOSCPage, pageNum);
-    currentOSCPage = pageNum;
+    oscColorStale++;
+    debugPrintf("Color bundle for page %d dropped (current page %d)\n", pageNum, currentOSCPage);
+    return;
+  }
+
+  if (parser.getArgCount() > expectedArgs && parser.getTag(expectedArgs) == 'i') {
+    noteConsoleUpdateSeq(CONSOLE_STREAM_COLOR, parser.getInt(expectedArgs));
   }
 
+  int badArgs = 0;
   for (int i = 0; i < NUM_EXECUTORS_TRACKED; ++i) {
     int argIndex = i + 1;
-    if (parser.getTag(argIndex) != 's') {
-      debugPrintf("Invalid color type for executor %d\n", EXECUTOR_IDS[i]);
+    const char* colorString = (parser.getTag(argIndex) == 's') ? parser.getString(argIndex) : nullptr;
+    if (colorString == nullptr || strnlen(colorString, OSC_MAX_COLOR_STRING + 1) > OSC_MAX_COLOR_STRING) {
+      badArgs++;
       continue;
     }
-    applyColorToExecutor(EXECUTOR_IDS[i], parser.getString(argIndex));
+    applyColorToExecutor(i, EXECUTOR_IDS[i], colorString);
+  }
+
+  if (badArgs > 0) {
+    oscMalformed++;
+    debugPrintf("Color bundle had %d invalid color arguments\n", badArgs);
+  } else {
+    pageCacheStoreColors(pageNum);
   }
 }
 
@@ -429,7 +1113,57 @@ void sendOscMessage(const char* address, const char* typeTag, const void* value)
     return;
   }
 
-  oscUdp.writeTo(buffer, len, netConfig.sendToIP, netConfig.sendPort);
+  sendToDestinations(buffer, len);
+}
+
+// Fader and key output goes to every console so it keeps flowing through a failover
+static void sendToDestinations(const uint8_t* buffer, size_t len) {
+  refreshDestinationAddresses();
+  for (uint8_t i = 0; i < OSC_MAX_DESTINATIONS; i++) {
+    OscDestination& dest = oscDestinations[i];
+    if (!dest.enabled) {
+      continue;
+    }
+    // The active console gets everything over the TCP stream (queued while it reconnects), the other over UDP
+    if (oscTcpQueueMessage(buffer, len, dest.ip)) {
+      dest.sent++;
+    } else if (oscUdp.writeTo(buffer, len, dest.ip, netConfig.sendPort) == len) {
+      dest.sent++;
+    } else {
+      dest.sendErrors++;
+    }
+  }
+}
+
+// Send one message carrying a list of int arguments
+void sendOscInts(const char* address, const int32_t* values, uint8_t count, const IPAddress& ip, uint16_t port) {
+  uint8_t buffer[64 + OSC_STATS_MAX_INTS * 5];
+  int len = 0;
+
+  if (count > OSC_STATS_MAX_INTS) count = OSC_STATS_MAX_INTS;
+
+  int addrLen = strlen(address);
+  if (addrLen > 48) {
+    debugPrint("OSC address too long.");
+    return;
+  }
+  memcpy(buffer + len, address, addrLen);
+  len += addrLen;
+  buffer[len++] = '\0';
+  while (len % 4 != 0) buffer[len++] = '\0';
+
+  buffer[len++] = ',';
+  for (uint8_t i = 0; i < count; i++) buffer[len++] = 'i';
+  buffer[len++] = '\0';
+  while (len % 4 != 0) buffer[len++] = '\0';
+
+  for (uint8_t i = 0; i < count; i++) {
+    uint32_t netOrder = htonl(static_cast<uint32_t>(values[i]));
+    memcpy(buffer + len, &netOrder, 4);
+    len += 4;
+  }
+
+  oscUdp.writeTo(buffer, len, ip, port);
 }
 
 
@@ -0,0 +1,310 @@
+// OscTcp.cpp
+
+#include "OscTcp.h"
+#include "NetworkOSC.h"
+#include "Config.h"
+#include "Utils.h"
+#include <string.h>
+
+//================================
+// SETTINGS
+//================================
+
+static constexpr size_t OSC_TCP_MAX_FRAME = 1536;           // Same limit as a queued UDP packet
+static constexpr size_t OSC_TCP_TX_BUFFER = 8192;           // Batch buffer, flushed once per loop and held while disconnected
+static constexpr uint32_t OSC_TCP_CONNECT_TIMEOUT_MS = 2000;
+static constexpr uint32_t OSC_TCP_MIN_BACKOFF_MS = 250;
+static constexpr uint32_t OSC_TCP_MAX_BACKOFF_MS = 8000;
+
+static constexpr uint8_t SLIP_END = 0xC0;
+static constexpr uint8_t SLIP_ESC = 0xDB;
+static constexpr uint8_t SLIP_ESC_END = 0xDC;
+static constexpr uint8_t SLIP_ESC_ESC = 0xDD;
+
+//================================
+// STATE
+//================================
+
+static EthernetClient oscTcpClient;
+static OscTcpStats oscTcpStats = {false, IPAddress(), 0, 0, 0, 0, 0, 0, 0, 0, 0, OSC_TCP_MIN_BACKOFF_MS};
+
+static bool connecting = false;
+static IPAddress targetIP;
+static uint32_t connectStartMs = 0;
+static uint32_t nextAttemptMs = 0;
+
+static uint8_t txBuffer[OSC_TCP_TX_BUFFER];
+static size_t txLen = 0;
+static size_t txPartial = 0;     // Head bytes that finish a frame the socket took only part of
+
+static uint8_t rxFrame[OSC_TCP_MAX_FRAME];
+static size_t rxLen = 0;
+static bool rxEscaped = false;
+static bool rxDiscard = false;   // Current frame overflowed, skip to the next END
+
+//================================
+// CONNECTION
+//================================
+
+static void clearTxQueue() {
+  txLen = 0;
+  txPartial = 0;
+}
+
+// Queued output survives a reconnect: key releases and final fader values still reach the console.
+// The rest of a half written frame does not; on a new connection it would be read as a frame.
+static void closeConnection(uint32_t retryDelayMs) {
+  if (txPartial > 0) {
+    txLen -= txPartial;
+    memmove(txBuffer, txBuffer + txPartial, txLen);
+    txPartial = 0;
+  }
+  oscTcpClient.stop();
+  connecting = false;
+  oscTcpStats.connected = false;
+  rxLen = 0;
+  rxEscaped = false;
+  rxDiscard = false;
+  nextAttemptMs = millis() + retryDelayMs;
+}
+
+// Settings changed: whatever is queued was meant for the old setup
+void oscTcpReset() {
+  if (oscTcpStats.connected || connecting) {
+    debugPrint("[OSC TCP] Closing connection");
+  }
+  closeConnection(0);
+  clearTxQueue();
+  oscTcpStats.backoffMs = OSC_TCP_MIN_BACKOFF_MS;
+}
+
+// The stream always goes to the active console, connected or not
+static const IPAddress& wantedTarget() {
+  return getOscDestination(getOscActiveSource()).ip;
+}
+
+static void updateConnection() {
+  const uint32_t now = millis();
+  const IPAddress& wanted = wantedTarget();
+
+  // Failover or new settings: follow the active console. The new one was sent everything
+  // over UDP while it was not the stream target, so the old queue is dropped.
+  if (targetIP != wanted) {
+    if (oscTcpStats.connected || connecting) {
+      closeConnection(0);
+    }
+    targetIP = wanted;
+    clearTxQueue();
+  }
+
+  if (connecting) {
+    if (oscTcpClient.connected()) {
+      connecting = false;
+      oscTcpStats.connected = true;
+      oscTcpStats.remoteIP = targetIP;
+      oscTcpStats.connects++;
+      oscTcpStats.backoffMs = OSC_TCP_MIN_BACKOFF_MS;
+      oscTcpClient.setNoDelay(true);
+      debugPrintf("[OSC TCP] Connected to %u.%u.%u.%u:%u\n", targetIP[0], targetIP[1], targetIP[2], targetIP[3], netConfig.sendPort);
+    } else if (now - connectStartMs > OSC_TCP_CONNECT_TIMEOUT_MS) {
+      oscTcpStats.connectFailures++;
+      closeConnection(oscTcpStats.backoffMs);
+      oscTcpStats.backoffMs = min(oscTcpStats.backoffMs * 2, OSC_TCP_MAX_BACKOFF_MS);
+    }
+    return;
+  }
+
+  if (oscTcpStats.connected) {
+    if (!oscTcpClient.connected()) {
+      oscTcpStats.disconnects++;
+      debugPrint("[OSC TCP] Connection lost");
+      closeConnection(OSC_TCP_MIN_BACKOFF_MS);
+    }
+    return;
+  }
+
+  if ((int32_t)(now - nextAttemptMs) >= 0) {
+    if (oscTcpClient.connectNoWait(targetIP, netConfig.sendPort)) {
+      connecting = true;
+      connectStartMs = now;
+    } else {
+      oscTcpStats.connectFailures++;
+      nextAttemptMs = now + oscTcpStats.backoffMs;
+      oscTcpStats.backoffMs = min(oscTcpStats.backoffMs * 2, OSC_TCP_MAX_BACKOFF_MS);
+    }
+  }
+}
+
+//================================
+// RECEIVE (SLIP DECODE)
+//================================
+
+static void finishFrame() {
+  if (rxLen > 0 && !rxDiscard) {
+    oscTcpStats.framesReceived++;
+    queueIncomingOsc(rxFrame, rxLen, targetIP, netConfig.sendPort);
+  }
+  rxLen = 0;
+  rxEscaped = false;
+  rxDiscard = false;
+}
+
+static void readFrames() {
+  uint8_t chunk[256];
+  int avail = oscTcpClient.available();
+  while (avail > 0) {
+    const int n = oscTcpClient.read(chunk, min((size_t)avail, sizeof(chunk)));
+    if (n <= 0) break;
+    avail -= n;
+
+    for (int i = 0; i < n; i++) {
+      uint8_t b = chunk[i];
+      if (b == SLIP_END) {
+        finishFrame();
+        continue;
+      }
+      if (rxEscaped) {
+        b = (b == SLIP_ESC_END) ? SLIP_END : (b == SLIP_ESC_ESC ? SLIP_ESC : b);
+        rxEscaped = false;
+      } else if (b == SLIP_ESC) {
+        rxEscaped = true;
+        continue;
+      }
+
+      if (rxLen < OSC_TCP_MAX_FRAME) {
+        rxFrame[rxLen++] = b;
+      } else if (!rxDiscard) {
+        rxDiscard = true;
+        oscTcpStats.rxOverflows++;
+      }
+    }
+  }
+}
+
+//================================
+// SEND (SLIP ENCODE + BATCH)
+//================================
+
+// Frames are END <data> END. A closing END follows a data byte, an opening END does not.
+// Whole frames start at txPartial, after the rest of a half written one.
+static bool isFrameEnd(size_t i) {
+  return i > txPartial && txBuffer[i] == SLIP_END && txBuffer[i - 1] != SLIP_END;
+}
+
+// Make room by dropping the oldest whole message: newer ones carry the latest state.
+// A half written frame is never cut, or the console would read garbage.
+static bool dropOldestFrame() {
+  if (txLen <= txPartial) {
+    return false;
+  }
+  size_t i = txPartial + 1;
+  while (i < txLen && !isFrameEnd(i)) i++;
+  const size_t end = min(i + 1, txLen);
+  memmove(txBuffer + txPartial, txBuffer + end, txLen - end);
+  txLen -= end - txPartial;
+  oscTcpStats.txOverflows++;
+  return true;
+}
+
+static void flushBatch();
+
+// Messages for the stream's console are always queued, also while the connection is down,
+// so they reach it in order once it is back; UDP would overtake what is still queued
+bool oscTcpQueueMessage(const uint8_t* data, size_t len, const IPAddress& ip) {
+  if (netConfig.oscTransport != OSC_TRANSPORT_TCP || ip != wantedTarget()) {
+    return false;
+  }
+
+  // Worst case every byte is escaped, plus the two END bytes
+  const size_t needed = len * 2 + 2;
+  if (needed > OSC_TCP_TX_BUFFER) {
+    return false;
+  }
+  if (txLen + needed > OSC_TCP_TX_BUFFER && oscTcpStats.connected) {
+    flushBatch();
+  }
+  while (txLen + needed > OSC_TCP_TX_BUFFER) {
+    if (!dropOldestFrame()) {
+      oscTcpStats.txOverflows++;   // Only the tail of a half written frame is left
+      return true;
+    }
+  }
+
+  txBuffer[txLen++] = SLIP_END;
+  for (size_t i = 0; i < len; i++) {
+    if (data[i] == SLIP_END) {
+      txBuffer[txLen++] = SLIP_ESC;
+      txBuffer[txLen++] = SLIP_ESC_END;
+    } else if (data[i] == SLIP_ESC) {
+      txBuffer[txLen++] = SLIP_ESC;
+      txBuffer[txLen++] = SLIP_ESC_ESC;
+    } else {
+      txBuffer[txLen++] = data[i];
+    }
+  }
+  txBuffer[txLen++] = SLIP_END;
+  oscTcpStats.framesSent++;
+  return true;
+}
+
+// Everything queued since the last loop goes out in as few segments as the window allows.
+// Whole messages are offered, but the socket may take fewer bytes than that: then the rest
+// of the cut frame stays at the head (txPartial) and goes first on the next flush.
+static void flushBatch() {
+  if (txLen == 0) return;
+
+  const int space = oscTcpClient.availableForWrite();
+  if (space <= 0) return;
+
+  size_t n = min((size_t)space, txLen);
+  if (n > txPartial) {
+    while (n > txPartial && !isFrameEnd(n - 1)) n--;
+  }
+  if (n == 0) return;
+
+  n = oscTcpClient.write(txBuffer, n);
+  if (n == 0) return;
+  oscTcpClient.flush();
+
+  oscTcpStats.batchesSent++;
+  oscTcpStats.bytesSent += n;
+
+  // Where the frame the socket stopped in ends, counted before the written bytes go
+  size_t rest = 0;
+  if (n < txPartial) {
+    rest = txPartial - n;
+  } else if (n > txPartial && !isFrameEnd(n - 1)) {
+    size_t end = n;
+    while (end < txLen && !isFrameEnd(end)) end++;
+    rest = end + 1 - n;
+  }
+
+  txLen -= n;
+  txPartial = rest;
+  if (txLen > 0) {
+    memmove(txBuffer, txBuffer + n, txLen);
+  }
+}
+
+//================================
+// MAIN LOOP HOOK
+//================================
+
+void oscTcpLoop() {
+  if (netConfig.oscTransport != OSC_TRANSPORT_TCP) {
+    if (oscTcpStats.connected || connecting) {
+      oscTcpReset();
+    }
+    return;
+  }
+
+  updateConnection();
+  if (!oscTcpStats.connected) return;
+
+  readFrames();
+  flushBatch();
+}
+
+const OscTcpStats& getOscTcpStats() {
+  return oscTcpStats;
+}
@@ -0,0 +1,152 @@
+// PageCache.cpp
+
+#include "PageCache.h"
+#include "FaderControl.h"
+#include "ExecutorStatus.h"
+#include "KeyLedControl.h"
+#include "NetworkOSC.h"
+#include "ConsoleLink.h"
+#include "Utils.h"
+#include <string.h>
+
+//================================
+// STATE
+//================================
+
+struct PageCacheEntry {
+  int      page;                                    // 0 = free slot
+  uint32_t lastUsed;                                // Higher is more recent
+  bool     hasExec;
+  bool     hasColors;
+  uint8_t  setpoints[NUM_FADERS];                   // Console values for faders 201-210 (0-100)
+  uint8_t  statuses[NUM_EXECUTORS_TRACKED];
+  uint8_t  colors[NUM_EXECUTORS_TRACKED][3];
+};
+
+static PageCacheEntry entries[PAGE_CACHE_SLOTS];
+static PageCacheStats cacheStats = {};
+static uint32_t useCounter = 0;
+static int reconcilePage = 0;    // Page last applied from the cache, checked against the next exec bundle
+
+//================================
+// SLOTS
+//================================
+
+static PageCacheEntry* findEntry(int page) {
+  for (uint8_t i = 0; i < PAGE_CACHE_SLOTS; i++) {
+    if (entries[i].page == page) return &entries[i];
+  }
+  return nullptr;
+}
+
+// Existing slot for the page, else a free one, else the least recently used
+static PageCacheEntry& slotFor(int page) {
+  PageCacheEntry* entry = findEntry(page);
+  if (!entry) {
+    entry = &entries[0];
+    for (uint8_t i = 0; i < PAGE_CACHE_SLOTS; i++) {
+      if (entries[i].page == 0) {
+        entry = &entries[i];
+        cacheStats.entries++;
+        break;
+      }
+      if (entries[i].lastUsed < entry->lastUsed) entry = &entries[i];
+    }
+    if (entry->page != 0) {
+      cacheStats.evictions++;
+    }
+    memset(entry, 0, sizeof(PageCacheEntry));
+    entry->page = page;
+  }
+  entry->lastUsed = ++useCounter;
+  return *entry;
+}
+
+//================================
+// STORE
+//================================
+
+void pageCacheStoreExec(int page, const uint8_t* setpoints) {
+  PageCacheEntry& entry = slotFor(page);
+
+  if (reconcilePage == page && entry.hasExec) {
+    if (memcmp(entry.setpoints, setpoints, NUM_FADERS) != 0 ||
+        memcmp(entry.statuses, executorStatus, NUM_EXECUTORS_TRACKED) != 0) {
+      cacheStats.corrections++;
+    }
+    reconcilePage = 0;
+  }
+
+  memcpy(entry.setpoints, setpoints, NUM_FADERS);
+  memcpy(entry.statuses, executorStatus, NUM_EXECUTORS_TRACKED);
+  entry.hasExec = true;
+}
+
+void pageCacheStoreColors(int page) {
+  PageCacheEntry& entry = slotFor(page);
+  memcpy(entry.colors, executorColors, sizeof(entry.colors));
+  entry.hasColors = true;
+}
+
+//================================
+// APPLY
+//================================
+
+bool pageCacheApply(int page) {
+  PageCacheEntry* entry = findEntry(page);
+  if (!entry || !entry->hasExec) {
+    cacheStats.misses++;
+    return false;
+  }
+
+  entry->lastUsed = ++useCounter;
+  cacheStats.hits++;
+  reconcilePage = page;
+
+  bool needToMoveFaders = false;
+
+  if (!calibrationInProgress) {
+    for (int i = 0; i < NUM_FADERS; i++) {
+      int faderIndex = getFaderIndexFromID(201 + i);
+      if (faderIndex < 0 || faderIndex >= NUM_FADERS || faders[faderIndex].touched) continue;
+      if (isStaleFaderEcho(faders[faderIndex], page, entry->setpoints[i])) continue;
+
+      if (abs(entry->setpoints[i] - readFadertoOSC(faders[faderIndex])) > Fconfig.targetTolerance) {
+        setFaderSetpoint(faderIndex, entry->setpoints[i]);
+        needToMoveFaders = true;
+      }
+    }
+  }
+
+  // Statuses and colors mark only the keys that changed
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+    setExecutorStateByIndex(i, entry->statuses[i]);
+  }
+
+  if (entry->hasColors) {
+    for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+      const uint8_t* c = entry->colors[i];
+      setExecutorColorByIndex(i, c[0], c[1], c[2]);
+
+      int faderIndex = getFaderIndexFromID(EXECUTOR_IDS[i]);
+      if (EXECUTOR_IDS[i] >= 201 && EXECUTOR_IDS[i] <= 210 && faderIndex >= 0 && faderIndex < NUM_FADERS) {
+        faders[faderIndex].red = c[0];
+        faders[faderIndex].green = c[1];
+        faders[faderIndex].blue = c[2];
+      }
+    }
+    // The console's color bundle for this page must be applied in full, not diffed against the old page
+    invalidateColorCache();
+  }
+
+  debugPrintf("Page %d applied from cache\n", page);
+
+  if (needToMoveFaders && consoleLinkAllowsMotion()) {
+    moveAllFadersToSetpoints();
+  }
+  return true;
+}
+
+const PageCacheStats& getPageCacheStats() {
+  return cacheStats;
+}
@@ -0,0 +1,366 @@
+// SacnReceiver.cpp
+
+#include "SacnReceiver.h"
+#include "NetworkOSC.h"
+#include "KeyLedControl.h"
+#include "Utils.h"
+#include <AsyncUDP_Teensy41.h>
+#include <QNEthernet.h>
+#include <string.h>
+
+using namespace qindesign::network;
+
+//================================
+// E1.31 PACKET LAYOUT
+//================================
+
+// Data packets have a fixed layout up to the slots, so every field is read in place
+static constexpr size_t E131_ACN_ID_OFFSET = 4;
+static constexpr size_t E131_ROOT_VECTOR_OFFSET = 18;
+static constexpr size_t E131_CID_OFFSET = 22;
+static constexpr size_t E131_FRAMING_VECTOR_OFFSET = 40;
+static constexpr size_t E131_SOURCE_NAME_OFFSET = 44;
+static constexpr size_t E131_PRIORITY_OFFSET = 108;
+static constexpr size_t E131_SEQUENCE_OFFSET = 111;
+static constexpr size_t E131_OPTIONS_OFFSET = 112;
+static constexpr size_t E131_UNIVERSE_OFFSET = 113;
+static constexpr size_t E131_DMP_VECTOR_OFFSET = 117;
+static constexpr size_t E131_VALUE_COUNT_OFFSET = 123;
+static constexpr size_t E131_START_CODE_OFFSET = 125;
+static constexpr size_t E131_SLOTS_OFFSET = 126;
+static constexpr size_t E131_CID_SIZE = 16;
+
+static constexpr uint32_t VECTOR_ROOT_E131_DATA = 0x00000004;
+static constexpr uint32_t VECTOR_E131_DATA_PACKET = 0x00000002;
+static constexpr uint8_t VECTOR_DMP_SET_PROPERTY = 0x02;
+static constexpr uint8_t OPTION_PREVIEW_DATA = 0x80;
+static constexpr uint8_t OPTION_STREAM_TERMINATED = 0x40;
+
+static const uint8_t ACN_PACKET_ID[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+
+//================================
+// SETTINGS
+//================================
+
+static constexpr uint16_t DMX_UNIVERSE_SIZE = 512;
+static constexpr uint32_t SACN_SOURCE_TIMEOUT_MS = 2500;    // E1.31 network data loss
+static constexpr int8_t SACN_SEQUENCE_WINDOW = -20;          // E1.31 6.7.2: older than this is a new run
+
+//================================
+// STATE
+//================================
+
+static AsyncUDP sacnUdp;
+static bool listening = false;
+static IPAddress joinedGroup;
+static bool groupJoined = false;
+static IPAddress joinedOnIp;
+static bool rejoinPending = false;      // Universe changed: join its group on the next loop
+static bool networkWasReady = false;
+
+// Written by the UDP callback, picked up once per LED frame
+static uint8_t rxSlots[DMX_UNIVERSE_SIZE];
+static uint8_t rxPriority = 0;
+static volatile bool rxFresh = false;
+static volatile bool rxTerminated = false;
+static volatile uint32_t rxLastMs = 0;
+static bool haveSource = false;
+static uint8_t sourceCid[E131_CID_SIZE];
+static uint8_t lastSequence = 0;
+
+// Used by the renderer
+static uint8_t slots[DMX_UNIVERSE_SIZE];
+static uint8_t renderedKeySlots[SACN_KEY_CHANNELS];
+static uint8_t activePriority = 0;
+static bool live = false;
+
+static SacnStats sacnStats = {};
+
+//================================
+// RECEIVE
+//================================
+
+static uint16_t readU16(const uint8_t* p) {
+  return ((uint16_t)p[0] << 8) | p[1];
+}
+
+static uint32_t readU32(const uint8_t* p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void handleSacnPacket(const uint8_t* data, size_t len) {
+  if (len < E131_SLOTS_OFFSET ||
+      memcmp(data + E131_ACN_ID_OFFSET, ACN_PACKET_ID, sizeof(ACN_PACKET_ID)) != 0 ||
+      readU32(data + E131_ROOT_VECTOR_OFFSET) != VECTOR_ROOT_E131_DATA ||
+      readU32(data + E131_FRAMING_VECTOR_OFFSET) != VECTOR_E131_DATA_PACKET ||
+      data[E131_DMP_VECTOR_OFFSET] != VECTOR_DMP_SET_PROPERTY ||
+      readU16(data + E131_UNIVERSE_OFFSET) != sacnConfig.universe ||
+      (data[E131_OPTIONS_OFFSET] & OPTION_PREVIEW_DATA) ||
+      data[E131_START_CODE_OFFSET] != 0) {
+    sacnStats.ignored++;
+    return;
+  }
+
+  const uint8_t* cid = data + E131_CID_OFFSET;
+  const uint8_t priority = min(data[E131_PRIORITY_OFFSET], (uint8_t)SACN_MAX_PRIORITY);
+  const uint8_t sequence = data[E131_SEQUENCE_OFFSET];
+  const bool fromSource = haveSource && memcmp(cid, sourceCid, E131_CID_SIZE) == 0;
+
+  // Only the source being used can end the stream; anyone else stopping changes nothing
+  if (data[E131_OPTIONS_OFFSET] & OPTION_STREAM_TERMINATED) {
+    if (fromSource) {
+      haveSource = false;
+      rxTerminated = true;
+    } else {
+      sacnStats.ignored++;
+    }
+    return;
+  }
+
+  if (fromSource) {
+    const int8_t diff = (int8_t)(sequence - lastSequence);
+    if (diff <= 0 && diff > SACN_SEQUENCE_WINDOW) {
+      sacnStats.outOfOrder++;
+      return;
+    }
+  } else {
+    // Another sender only takes over from a live one with a higher priority
+    if (haveSource && priority <= rxPriority) {
+      sacnStats.lowerPriority++;
+      return;
+    }
+    memcpy(sourceCid, cid, E131_CID_SIZE);
+    memcpy(sacnStats.sourceName, data + E131_SOURCE_NAME_OFFSET, sizeof(sacnStats.sourceName) - 1);
+    sacnStats.sourceName[sizeof(sacnStats.sourceName) - 1] = '\0';
+    haveSource = true;
+    sacnStats.sourceChanges++;
+  }
+  lastSequence = sequence;
+
+  // Property value count includes the start code; short universes leave the rest dark
+  size_t count = readU16(data + E131_VALUE_COUNT_OFFSET);
+  count = (count > 0) ? count - 1 : 0;
+  count = min(count, min(len - E131_SLOTS_OFFSET, (size_t)DMX_UNIVERSE_SIZE));
+  memcpy(rxSlots, data + E131_SLOTS_OFFSET, count);
+  memset(rxSlots + count, 0, DMX_UNIVERSE_SIZE - count);
+
+  rxPriority = priority;
+  rxLastMs = millis();
+  rxFresh = true;
+  sacnStats.packets++;
+}
+
+//================================
+// LISTENER AND MULTICAST GROUP
+//================================
+
+static void leaveSacnGroup() {
+  if (groupJoined) {
+    Ethernet.leaveGroup(joinedGroup);
+    groupJoined = false;
+  }
+}
+
+static void joinSacnGroup() {
+  leaveSacnGroup();
+  const IPAddress group(239, 255, sacnConfig.universe >> 8, sacnConfig.universe & 0xFF);
+  if (Ethernet.joinGroup(group)) {
+    joinedGroup = group;
+    groupJoined = true;
+    debugPrintf("sACN joined %u.%u.%u.%u\n", group[0], group[1], group[2], group[3]);
+  } else {
+    debugPrint("sACN failed to join multicast group");
+  }
+}
+
+static void releaseSource() {
+  if (live) {
+    live = false;
+    markKeyLedsDirty();   // Every key merged with sACN goes back to its appearance color
+  }
+}
+
+void setupSacn() {
+  if (listening) {
+    sacnUdp.close();
+    listening = false;
+  }
+  leaveSacnGroup();
+  joinedOnIp = IPAddress(0, 0, 0, 0);
+  rejoinPending = true;
+
+  noInterrupts();
+  haveSource = false;
+  rxFresh = false;
+  rxTerminated = false;
+  interrupts();
+  releaseSource();
+  sacnStats.universe = 0;
+
+  if (!sacnConfig.enabled) {
+    return;
+  }
+
+  if (!sacnUdp.listen(SACN_PORT)) {
+    debugPrint("Failed to start sACN listener");
+    return;
+  }
+  sacnUdp.onPacket([](AsyncUDPPacket &packet) {
+    handleSacnPacket(packet.data(), packet.length());
+  });
+  listening = true;
+  sacnStats.universe = sacnConfig.universe;
+  debugPrintf("sACN listening for universe %u on port %d\n", sacnConfig.universe, SACN_PORT);
+}
+
+void sacnLoop() {
+  if (!listening) {
+    return;
+  }
+  if (!networkReady()) {
+    networkWasReady = false;
+    return;
+  }
+
+  // Join again after a settings save, on link up (switches forget the membership while
+  // the port is down) and after an address change
+  const IPAddress ip = Ethernet.localIP();
+  if (rejoinPending || !networkWasReady || ip != joinedOnIp) {
+    rejoinPending = false;
+    networkWasReady = true;
+    joinedOnIp = ip;
+    joinSacnGroup();
+  }
+}
+
+//================================
+// LED FRAME
+//================================
+
+void updateSacnInput() {
+  if (!listening) {
+    return;
+  }
+
+  const uint32_t now = millis();
+  bool terminated = false;
+  bool timedOut = false;
+  bool fresh = false;
+  uint8_t priority = activePriority;
+
+  noInterrupts();
+  if (rxTerminated) {
+    rxTerminated = false;
+    terminated = true;
+  } else if (haveSource && now - rxLastMs > SACN_SOURCE_TIMEOUT_MS) {
+    haveSource = false;
+    timedOut = true;
+  }
+  if (rxFresh) {
+    memcpy(slots, rxSlots, DMX_UNIVERSE_SIZE);
+    priority = rxPriority;
+    rxFresh = false;
+    fresh = true;
+  }
+  interrupts();
+
+  if (terminated || timedOut) {
+    if (timedOut) {
+      sacnStats.timeouts++;
+    }
+    if (live) {
+      debugPrintf("sACN source %s %s\n", sacnStats.sourceName, timedOut ? "timed out" : "stopped");
+    }
+    releaseSource();
+  }
+
+  if (fresh) {
+    if (!live || priority != activePriority) {
+      // Starting, or the merge rule changed: every key is redrawn
+      live = true;
+      activePriority = priority;
+      markKeyLedsDirty();
+    } else if (sacnConfig.keyAddress != 0) {
+      const uint8_t* keySlots = slots + sacnConfig.keyAddress - 1;
+      for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+        if (memcmp(keySlots + i * 3, renderedKeySlots + i * 3, 3) != 0) {
+          markKeyLedDirty(i);
+        }
+      }
+    }
+    if (sacnConfig.keyAddress != 0) {
+      memcpy(renderedKeySlots, slots + sacnConfig.keyAddress - 1, SACN_KEY_CHANNELS);
+    }
+  }
+
+  sacnStats.live = live;
+  sacnStats.priority = activePriority;
+}
+
+// Keys are only redrawn when marked dirty (updateSacnInput marks the ones whose slots
+// changed). Fader colors go through here every frame before updateNeoPixels compares them
+// with the last rendered color, so a changed slot redraws its segment without a mark.
+static bool mergeSlots(uint16_t address, int index, uint32_t& color) {
+  if (!live || address == 0) {
+    return false;
+  }
+
+  const uint8_t* rgb = slots + address - 1 + index * 3;
+  const uint32_t sacnColor = ((uint32_t)rgb[0] << 16) | ((uint32_t)rgb[1] << 8) | rgb[2];
+  uint32_t merged;
+
+  if (activePriority > sacnConfig.wingPriority) {
+    merged = sacnColor;
+  } else if (activePriority == sacnConfig.wingPriority) {
+    merged = max(color & 0xFF0000, sacnColor & 0xFF0000) |
+             max(color & 0x00FF00, sacnColor & 0x00FF00) |
+             max(color & 0x0000FF, sacnColor & 0x0000FF);
+  } else {
+    return false;
+  }
+
+  if (merged == color) {
+    return false;
+  }
+  color = merged;
+  return true;
+}
+
+bool mergeSacnFaderColor(int faderIndex, uint32_t& color) {
+  if (faderIndex < 0 || faderIndex >= NUM_FADERS) {
+    return false;
+  }
+  const int position = faders[faderIndex].oscID - 201;   // Channel order follows the fader numbers
+  if (position < 0 || position >= NUM_FADERS) {
+    return false;
+  }
+  return mergeSlots(sacnConfig.faderAddress, position, color);
+}
+
+bool mergeSacnKeyColor(int execIndex, uint32_t& color) {
+  if (execIndex < 0 || execIndex >= NUM_EXECUTORS_TRACKED) {
+    return false;
+  }
+  return mergeSlots(sacnConfig.keyAddress, execIndex, color);
+}
+
+//================================
+// CONFIG AND STATS
+//================================
+
+bool isValidSacnConfig(const SacnConfig& config) {
+  if (config.universe < 1 || config.universe > 63999 || config.wingPriority > SACN_MAX_PRIORITY) {
+    return false;
+  }
+  if (config.faderAddress > DMX_UNIVERSE_SIZE - SACN_FADER_CHANNELS + 1) {
+    return false;
+  }
+  if (config.keyAddress > DMX_UNIVERSE_SIZE - SACN_KEY_CHANNELS + 1) {
+    return false;
+  }
+  return true;
+}
+
+const SacnStats& getSacnStats() {
+  return sacnStats;
+}
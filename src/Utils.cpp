@@ -4,6 +4,7 @@
 #include "Utils.h"
 #include "Config.h"
 #include <stdarg.h>
+#include <ctype.h>
 
 extern OLED display;
 
@@ -64,6 +65,24 @@ String getParam(String data, const char* key) {
   return data.substring(start, end);
 }
 
+String urlDecode(const String& s) {
+  String out;
+  out.reserve(s.length());
+  for (unsigned int i = 0; i < s.length(); i++) {
+    char c = s[i];
+    if (c == '+') {
+      out += ' ';
+    } else if (c == '%' && i + 2 < s.length() && isxdigit(s[i + 1]) && isxdigit(s[i + 2])) {
+      char hex[3] = {s[i + 1], s[i + 2], '\0'};
+      out += (char)strtol(hex, nullptr, 16);
+      i += 2;
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
 //================================
 // UPLOAD Function 
 //================================
@@ -9,7 +9,13 @@
 #include "NeoPixelControl.h"
 #include "OLED.h"
 #include "NetworkOSC.h"
+#include "OscTcp.h"
+#include "ConsoleLink.h"
+#include "PageCache.h"
+#include "LwipStats.h"
 #include "KeyLedControl.h"
+#include "ExecutorStatus.h"
+#include "SacnReceiver.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -214,8 +220,14 @@ void handleWebServer() {
         } else if (request.indexOf("touchThreshold=") >= 0) {
           requestType = 'T'; // Touch settings
           debugPrint("Determined: Touch settings");
+        } else if (request.indexOf("sacn_u=") >= 0) {
+          requestType = 'U'; // sACN input settings
+          debugPrint("Determined: sACN settings");
+        } else if (request.indexOf("km=") >= 0) {
+          requestType = 'K'; // Exec key LED map
+          debugPrint("Determined: Key LED map");
         } else if (request.indexOf("bb=") >= 0 || request.indexOf("tb=") >= 0 || 
-                   request.indexOf("ft=") >= 0 || request.indexOf("lp=") >= 0 ||
+                   request.indexOf("ft=") >= 0 || request.indexOf("lp=") >= 0 || request.indexOf("dd=") >= 0 ||
                    request.indexOf("eb=") >= 0 || request.indexOf("ea=") >= 0 ||
                    request.indexOf("sc=") >= 0 || request.indexOf("sch=") >= 0) {
           requestType = 'V'; // LED settings only
@@ -292,6 +304,14 @@ void handleWebServer() {
           handleFaderSettings(request);
           break;
 
+        case 'U': // sACN input settings save
+          handleSacnSettingsSave(request);
+          break;
+
+        case 'K': // Exec key LED map save
+          handleKeyLedMapSave(request);
+          break;
+
         case 'V': // LED settings save
           handleLEDSettingsSave(request);
           break;
@@ -496,12 +516,31 @@ void handleOSCSettingsPage() {
                  "<label>OSC Send IP</label><input type='text' name='osc_sendip' value='"));
   client.print(ipToString(netConfig.sendToIP));
   client.print(F("'><p class='help'>IP address of GMA3 console</p>"
+                 "<label><input type='checkbox' name='osc_backup' value='on'"));
+  if (netConfig.useBackup) client.print(F(" checked"));
+  client.print(F("> Send to a backup console and fail over to it</label>"
+                 "<label>Backup Console IP</label><input type='text' name='osc_backupip' value='"));
+  client.print(ipToString(netConfig.backupIP));
+  client.print(F("'><p class='help'>Output goes to both consoles; input is taken from the backup when the main console goes quiet</p>"
                  "<label>OSC Send Port</label><input type='number' name='osc_sendport' value='"));
   client.print(netConfig.sendPort);
   client.print(F("'>"
                  "<label>OSC Receive Port</label><input type='number' name='osc_receiveport' value='"));
   client.print(netConfig.receivePort);
   client.print(F("'>"
+                 "<label>OSC Transport</label><select name='osc_transport'>"
+                 "<option value='0'"));
+  if (netConfig.oscTransport == OSC_TRANSPORT_UDP) client.print(F(" selected"));
+  client.print(F(">UDP</option><option value='1'"));
+  if (netConfig.oscTransport == OSC_TRANSPORT_TCP) client.print(F(" selected"));
+  client.print(F(">TCP (SLIP framed)</option></select>"
+                 "<p class='help'>TCP connects to the console on the send port so key releases and fader finals cannot be lost; UDP is used while it is not connected</p>"
+                 "<label><input type='checkbox' name='osc_mcast' value='on'"));
+  if (netConfig.useMulticast) client.print(F(" checked"));
+  client.print(F("> Also receive OSC on a multicast group</label>"
+                 "<label>OSC Multicast Group</label><input type='text' name='osc_mcastip' value='"));
+  client.print(ipToString(netConfig.multicastIP));
+  client.print(F("'><p class='help'>239.x.x.x address; point the GMA3 OSC entry at this group to drive several wings with one send</p>"
                  "<hr style='border:0;border-top:1px solid #2d3133;margin:14px 0;'>"
                  "<label>"));
   client.print(F("<input type='checkbox' name='sendKeystrokes' value='on'"));
@@ -621,6 +660,7 @@ void handleLEDSettingsSave(String request) {
   String touchedBrightnessStr = getParam(request, "tb");
   String fadeTimeStr = getParam(request, "ft");
   bool newUseLevelPixels = (request.indexOf("lp=on") >= 0 || request.indexOf("lp=1") >= 0);
+  bool newDitherDimColors = (request.indexOf("dd=on") >= 0 || request.indexOf("dd=1") >= 0);
   String execBaseBrightnessStr = getParam(request, "eb");
   String execActiveBrightnessStr = getParam(request, "ea");
   bool newUseStaticColor = (request.indexOf("sc=on") >= 0 || request.indexOf("sc=1") >= 0);
@@ -663,6 +703,9 @@ void handleLEDSettingsSave(String request) {
   Fconfig.useLevelPixels = newUseLevelPixels;
   debugPrintf("Use Level Pixels: %s\n", Fconfig.useLevelPixels ? "true" : "false");
 
+  Fconfig.ditherDimColors = newDitherDimColors;
+  debugPrintf("Dither Dim Colors: %s\n", Fconfig.ditherDimColors ? "true" : "false");
+
   if (execBaseBrightnessStr.length() > 0) {
     int execBase = execBaseBrightnessStr.toInt();
     execConfig.baseBrightness = constrainParam(execBase, 0, 255, execConfig.baseBrightness);
@@ -699,6 +742,76 @@ void handleLEDSettingsSave(String request) {
   sendMessagePage("LED Settings Saved", "LED settings have been saved successfully.", "/led_settings", 3);
 }
 
+void handleKeyLedMapSave(String request) {
+  debugPrint("Handling key LED map...");
+
+  // "start:count" per key, comma separated, in EXECUTOR_IDS order
+  String map = urlDecode(getParam(request, "km"));
+  KeyLedMap newMap = {};
+  int pos = 0;
+
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+    int sep = map.indexOf(',', pos);
+    if (sep == -1) sep = map.length();
+    String entry = map.substring(pos, sep);
+    int colon = entry.indexOf(':');
+    if (colon <= 0) {
+      sendErrorResponse("Key LED map needs a start:pixels pair for every key.");
+      return;
+    }
+
+    int start = entry.substring(0, colon).toInt();
+    int count = entry.substring(colon + 1).toInt();
+    if (start < 0 || count < 0 || count > KEY_LED_MAX_PIXELS || start + count > LED_STRIP_LENGTH) {
+      char msg[96];
+      snprintf(msg, sizeof(msg), "Key %d: pixels %d+%d do not fit the strip (%d pixels, up to %d per key).",
+               EXECUTOR_IDS[i], start, count, LED_STRIP_LENGTH, KEY_LED_MAX_PIXELS);
+      sendErrorResponse(msg);
+      return;
+    }
+    newMap.keys[i].start = start;
+    newMap.keys[i].count = count;
+    pos = sep + 1;
+  }
+
+  keyLedMap = newMap;
+  saveKeyLedMap();
+  applyKeyLedMap();
+  sendMessagePage("Key LED Map Saved", "Exec key LED map has been saved successfully.", "/led_settings", 3);
+}
+
+void handleSacnSettingsSave(String request) {
+  debugPrint("Handling sACN settings...");
+
+  int universe = getParam(request, "sacn_u").toInt();
+  int faderAddress = getParam(request, "sacn_fa").toInt();
+  int keyAddress = getParam(request, "sacn_ka").toInt();
+
+  SacnConfig newConfig = sacnConfig;
+  newConfig.enabled = (request.indexOf("sacn_en=on") >= 0 || request.indexOf("sacn_en=1") >= 0);
+  newConfig.universe = constrain(universe, 0, 65535);
+  newConfig.faderAddress = constrain(faderAddress, 0, 65535);
+  newConfig.keyAddress = constrain(keyAddress, 0, 65535);
+  newConfig.wingPriority = constrainParam(getParam(request, "sacn_pri").toInt(), 0, SACN_MAX_PRIORITY, sacnConfig.wingPriority);
+
+  if (universe != newConfig.universe || faderAddress != newConfig.faderAddress ||
+      keyAddress != newConfig.keyAddress || !isValidSacnConfig(newConfig)) {
+    char msg[128];
+    snprintf(msg, sizeof(msg), "sACN: universe must be 1-63999, fader address 0-%d and key address 0-%d.",
+             512 - SACN_FADER_CHANNELS + 1, 512 - SACN_KEY_CHANNELS + 1);
+    sendErrorResponse(msg);
+    return;
+  }
+
+  sacnConfig = newConfig;
+  saveSacnConfig();
+  setupSacn();
+  debugPrintf("sACN %s, universe %u, faders @%u, keys @%u, wing priority %u\n",
+              sacnConfig.enabled ? "enabled" : "disabled", sacnConfig.universe,
+              sacnConfig.faderAddress, sacnConfig.keyAddress, sacnConfig.wingPriority);
+  sendMessagePage("sACN Settings Saved", "sACN input settings have been saved successfully.", "/led_settings", 3);
+}
+
 void handleRunCalibration() {
   debugPrint("Running fader calibration...");
 
@@ -780,6 +893,11 @@ void handleOSCSettings(String request) {
   String sendIPStr = getParam(request, "osc_sendip");
   String sendPortStr = getParam(request, "osc_sendport");
   String receivePortStr = getParam(request, "osc_receiveport");
+  String multicastIPStr = getParam(request, "osc_mcastip");
+  bool newUseMulticast = (request.indexOf("osc_mcast=on") >= 0);
+  String transportStr = getParam(request, "osc_transport");
+  String backupIPStr = getParam(request, "osc_backupip");
+  bool newUseBackup = (request.indexOf("osc_backup=on") >= 0);
   
   // NEW: Extract sendKeystrokes checkbox
   bool newSendKeystrokes = (request.indexOf("sendKeystrokes=on") >= 0 || request.indexOf("sendKeystrokes=1") >= 0);
@@ -824,6 +942,39 @@ void handleOSCSettings(String request) {
     }
   }
   
+  // Validate and update multicast group
+  if (multicastIPStr.length() > 0) {
+    IPAddress newMulticastIP = stringToIP(multicastIPStr);
+    if (isMulticastAddress(newMulticastIP)) {
+      netConfig.multicastIP = newMulticastIP;
+      debugPrintf("Updated OSC Multicast Group: %s\n", ipToString(netConfig.multicastIP).c_str());
+    } else {
+      debugPrintf("ERROR: Invalid OSC multicast group: %s\n", multicastIPStr.c_str());
+      sendErrorResponse("Invalid OSC multicast group (must be 224.0.0.0 - 239.255.255.255)");
+      return;
+    }
+  }
+  netConfig.useMulticast = newUseMulticast;
+
+  // Validate and update backup console
+  if (backupIPStr.length() > 0) {
+    IPAddress newBackupIP = stringToIP(backupIPStr);
+    if (isValidIP(newBackupIP) && isValidDestination(newBackupIP)) {
+      netConfig.backupIP = newBackupIP;
+      debugPrintf("Updated OSC Backup IP: %s\n", ipToString(netConfig.backupIP).c_str());
+    } else {
+      debugPrintf("ERROR: Invalid OSC backup IP: %s\n", backupIPStr.c_str());
+      sendErrorResponse("Invalid backup console IP address");
+      return;
+    }
+  }
+  netConfig.useBackup = newUseBackup;
+
+  if (transportStr.length() > 0) {
+    netConfig.oscTransport = (transportStr.toInt() == OSC_TRANSPORT_TCP) ? OSC_TRANSPORT_TCP : OSC_TRANSPORT_UDP;
+    debugPrintf("Updated OSC Transport: %s\n", netConfig.oscTransport == OSC_TRANSPORT_TCP ? "TCP" : "UDP");
+  }
+
   // NEW: Update sendKeystrokes setting
   Fconfig.sendKeystrokes = newSendKeystrokes;
   debugPrintf("Updated sendKeystrokes: %s\n", Fconfig.sendKeystrokes ? "true" : "false");
@@ -831,6 +982,8 @@ void handleOSCSettings(String request) {
   // Save both network config (for OSC settings) and fader config (for sendKeystrokes)
   saveNetworkConfig();
   saveFaderConfig();  // NEW: Save fader config for sendKeystrokes setting
+  updateMulticastMembership();
+  oscTcpReset();
 
   debugPrint("OSC settings saved successfully");
   sendMessagePage("OSC Settings Saved", "OSC settings have been saved successfully. For changes to take full effect, you may have to restart the device.", "/osc_settings", 3);
@@ -917,6 +1070,10 @@ String topHeader;
   topHeader += ipToString(Ethernet.localIP());
   topHeader += ":";
   topHeader += netConfig.receivePort;
+  if (netConfig.useMulticast) {
+    topHeader += " + ";
+    topHeader += ipToString(netConfig.multicastIP);
+  }
   topHeader += " | Key Send Mode: ";
   topHeader += Fconfig.sendKeystrokes ? "USB" : "OSC";
 
@@ -1031,7 +1188,282 @@ void handleStatsData() {
 
     if (i % 3 == 0) waitForWriteSpace(200);
   }
-  client.println(F("]}"));
+  client.print(']');
+
+  waitForWriteSpace(400);
+  const OscBudgetStats& budget = getOscBudgetStats();
+  client.print(F(",\"oscBudget\":{\"budgetUs\":"));
+  client.print(budget.budgetUs);
+  client.print(F(",\"packetLimit\":"));
+  client.print(budget.packetLimit);
+  client.print(F(",\"reason\":\""));
+  client.print(oscBudgetReasonName(budget.lastReason));
+  client.print(F("\",\"loopOtherUs\":"));
+  client.print(budget.loopOtherUs);
+  client.print(F(",\"oscStageUs\":"));
+  client.print(budget.oscStageUs);
+  client.print(F(",\"decisions\":{"));
+  for (uint8_t r = 0; r < OSC_BUDGET_REASON_COUNT; r++) {
+    if (r > 0) client.print(',');
+    client.print('"');
+    client.print(oscBudgetReasonName(r));
+    client.print(F("\":"));
+    client.print(budget.decisions[r]);
+  }
+  client.print(F("}}"));
+
+  waitForWriteSpace(400);
+  OscRxStats rx;
+  getOscRxStats(rx);
+  client.print(F(",\"oscRx\":{\"received\":"));
+  client.print(rx.received);
+  client.print(F(",\"handled\":{"));
+  for (uint8_t t = 0; t < OSC_MSG_TYPE_COUNT; t++) {
+    if (t > 0) client.print(',');
+    client.print('"');
+    client.print(oscMsgTypeName(t));
+    client.print(F("\":"));
+    client.print(rx.handled[t]);
+  }
+  client.print(F("},\"queueDrops\":"));
+  client.print(rx.queueDrops);
+  client.print(F(",\"oversize\":"));
+  client.print(rx.oversizeDrops);
+  client.print(F(",\"coalesced\":"));
+  client.print(rx.colorCoalesced);
+  client.print(F(",\"colorStale\":"));
+  client.print(rx.colorStale);
+  client.print(F(",\"parseFailures\":"));
+  client.print(rx.parseFailures);
+  client.print(F(",\"malformed\":"));
+  client.print(rx.malformed);
+  client.print(F(",\"highWater\":"));
+  client.print(rx.queueHighWater);
+  client.print(F(",\"latencyLastUs\":"));
+  client.print(rx.latencyLastUs);
+  client.print(F(",\"latencyMaxUs\":"));
+  client.print(rx.latencyMaxUs);
+  client.print(F(",\"latency\":["));
+  for (uint8_t b = 0; b < OSC_LATENCY_BUCKETS; b++) {
+    if (b > 0) client.print(',');
+    client.print(F("{\"le\":"));
+    client.print(oscLatencyBucketLimitUs(b));
+    client.print(F(",\"n\":"));
+    client.print(rx.latencyHist[b]);
+    client.print('}');
+  }
+  client.print(F("]}"));
+
+  waitForWriteSpace(400);
+  const uint32_t now = millis();
+  client.print(F(",\"oscDest\":{\"active\":"));
+  client.print(getOscActiveSource());
+  client.print(F(",\"failovers\":"));
+  client.print(getOscFailoverCount());
+  client.print(F(",\"list\":["));
+  for (uint8_t d = 0; d < OSC_MAX_DESTINATIONS; d++) {
+    const OscDestination& dest = getOscDestination(d);
+    if (d > 0) client.print(',');
+    client.print(F("{\"ip\":\""));
+    client.print(ipToString(dest.ip));
+    client.print(F("\",\"enabled\":"));
+    client.print(dest.enabled ? F("true") : F("false"));
+    client.print(F(",\"sent\":"));
+    client.print(dest.sent);
+    client.print(F(",\"sendErrors\":"));
+    client.print(dest.sendErrors);
+    client.print(F(",\"received\":"));
+    client.print(dest.received);
+    client.print(F(",\"ignored\":"));
+    client.print(dest.ignored);
+    client.print(F(",\"lastHeardMs\":"));
+    client.print(dest.heard ? (long)(now - dest.lastHeardMs) : -1L);
+    client.print('}');
+  }
+  client.print(F("]}"));
+
+  const OscTcpStats& tcp = getOscTcpStats();
+  client.print(F(",\"oscTcp\":{\"enabled\":"));
+  client.print(netConfig.oscTransport == OSC_TRANSPORT_TCP ? F("true") : F("false"));
+  client.print(F(",\"connected\":"));
+  client.print(tcp.connected ? F("true") : F("false"));
+  client.print(F(",\"remote\":\""));
+  client.print(ipToString(tcp.remoteIP));
+  client.print(F("\",\"connects\":"));
+  client.print(tcp.connects);
+  client.print(F(",\"connectFailures\":"));
+  client.print(tcp.connectFailures);
+  client.print(F(",\"disconnects\":"));
+  client.print(tcp.disconnects);
+  client.print(F(",\"framesSent\":"));
+  client.print(tcp.framesSent);
+  client.print(F(",\"batches\":"));
+  client.print(tcp.batchesSent);
+  client.print(F(",\"framesReceived\":"));
+  client.print(tcp.framesReceived);
+  client.print(F(",\"txOverflows\":"));
+  client.print(tcp.txOverflows);
+  client.print(F(",\"backoffMs\":"));
+  client.print(tcp.backoffMs);
+  client.print('}');
+
+  waitForWriteSpace(300);
+  const ConsoleLinkStats& link = getConsoleLinkStats();
+  client.print(F(",\"consoleLink\":{\"state\":\""));
+  client.print(consoleLinkStateName(link.state));
+  client.print(F("\",\"pings\":"));
+  client.print(link.pingsSent);
+  client.print(F(",\"pongs\":"));
+  client.print(link.pongsReceived);
+  client.print(F(",\"late\":"));
+  client.print(link.latePongs);
+  client.print(F(",\"otherWing\":"));
+  client.print(link.otherWingPongs);
+  client.print(F(",\"seq\":"));
+  client.print(link.lastSeq);
+  client.print(F(",\"rttMs\":"));
+  client.print(link.lastRttMs);
+  client.print(F(",\"srttMs\":"));
+  client.print(link.srttMs);
+  client.print(F(",\"jitterMs\":"));
+  client.print(link.jitterMs);
+  client.print(F(",\"lastPongMs\":"));
+  client.print(link.pongsReceived ? (long)link.lastPongAgeMs : -1L);
+  client.print(F(",\"lost\":"));
+  client.print(link.lostCount);
+  client.print(F(",\"resyncs\":"));
+  client.print(link.resyncRequests);
+  client.print(F(",\"resyncReasons\":{"));
+  for (uint8_t r = 0; r < RESYNC_REASON_COUNT; r++) {
+    if (r > 0) client.print(',');
+    client.print('"');
+    client.print(consoleResyncReasonName(r));
+    client.print(F("\":"));
+    client.print(link.resyncByReason[r]);
+  }
+  client.print(F("},\"seqGaps\":"));
+  client.print(link.seqGaps);
+  client.print(F(",\"missedUpdates\":"));
+  client.print(link.missedUpdates);
+  client.print(F(",\"faderEchoes\":"));
+  client.print(getFaderEchoesIgnored());
+  const KeyLedPredictionStats& keys = getKeyLedPredictionStats();
+  client.print(F(",\"keyPredictions\":"));
+  client.print(keys.predicted);
+  client.print(F(",\"keyConfirmed\":"));
+  client.print(keys.confirmed);
+  client.print(F(",\"keyReverted\":"));
+  client.print(keys.reverted);
+  client.print('}');
+
+  const PageCacheStats& cache = getPageCacheStats();
+  client.print(F(",\"pageCache\":{\"entries\":"));
+  client.print(cache.entries);
+  client.print(F(",\"hits\":"));
+  client.print(cache.hits);
+  client.print(F(",\"misses\":"));
+  client.print(cache.misses);
+  client.print(F(",\"corrections\":"));
+  client.print(cache.corrections);
+  client.print(F(",\"evictions\":"));
+  client.print(cache.evictions);
+  client.print('}');
+
+  client.print(F(",\"leds\":{\"rate\":"));
+  client.print(LED_FRAME_RATE);
+  client.print(F(",\"transferUs\":"));
+  client.print(ledEngine.transferUs());
+  client.print(F(",\"rendered\":"));
+  client.print(ledEngine.framesRendered());
+  client.print(F(",\"shown\":"));
+  client.print(ledEngine.framesShown());
+  client.print(F(",\"deferred\":"));
+  client.print(ledEngine.framesDeferred());
+  client.print(F(",\"renderUs\":"));
+  client.print(ledEngine.lastRenderUs());
+  client.print(F(",\"renderMaxUs\":"));
+  client.print(ledEngine.maxRenderUs());
+  client.print(F(",\"dithered\":"));
+  client.print(getDitheredFrameCount());
+  client.print('}');
+
+  waitForWriteSpace(300);
+  const SacnStats& sacn = getSacnStats();
+  client.print(F(",\"sacn\":{\"universe\":"));
+  client.print(sacn.universe);
+  client.print(F(",\"live\":"));
+  client.print(sacn.live ? F("true") : F("false"));
+  client.print(F(",\"priority\":"));
+  client.print(sacn.priority);
+  client.print(F(",\"source\":\""));
+  for (const char* c = sacn.sourceName; *c; c++) {
+    if (*c >= ' ' && *c != '"' && *c != '\\') client.print(*c);   // Names come off the wire
+  }
+  client.print(F("\",\"packets\":"));
+  client.print(sacn.packets);
+  client.print(F(",\"ignored\":"));
+  client.print(sacn.ignored);
+  client.print(F(",\"outOfOrder\":"));
+  client.print(sacn.outOfOrder);
+  client.print(F(",\"lowerPriority\":"));
+  client.print(sacn.lowerPriority);
+  client.print(F(",\"sourceChanges\":"));
+  client.print(sacn.sourceChanges);
+  client.print(F(",\"timeouts\":"));
+  client.print(sacn.timeouts);
+  client.print('}');
+
+  waitForWriteSpace(600);
+  LwipStackStats stack;
+  getLwipStackStats(stack);
+  client.print(F(",\"lwip\":{\"heap\":{\"used\":"));
+  client.print(stack.heapUsed);
+  client.print(F(",\"max\":"));
+  client.print(stack.heapMax);
+  client.print(F(",\"avail\":"));
+  client.print(stack.heapAvail);
+  client.print(F(",\"err\":"));
+  client.print(stack.heapErr);
+  client.print(F("},\"linkDrops\":"));
+  client.print(stack.linkDrops);
+  client.print(F(",\"udp\":{\"recv\":"));
+  client.print(stack.udpRecv);
+  client.print(F(",\"xmit\":"));
+  client.print(stack.udpXmit);
+  client.print(F(",\"drop\":"));
+  client.print(stack.udpDrops);
+  client.print(F(",\"memerr\":"));
+  client.print(stack.udpMemErrors);
+  client.print(F("},\"tcp\":{\"recv\":"));
+  client.print(stack.tcpRecv);
+  client.print(F(",\"xmit\":"));
+  client.print(stack.tcpXmit);
+  client.print(F(",\"drop\":"));
+  client.print(stack.tcpDrops);
+  client.print(F(",\"rexmit\":"));
+  client.print(stack.tcpRetransmits);
+  client.print(F(",\"memerr\":"));
+  client.print(stack.tcpMemErrors);
+  client.print(F("},\"pools\":["));
+  bool firstPool = true;
+  for (uint8_t p = 0; p < getLwipPoolCount(); p++) {
+    LwipPoolStats pool;
+    if (!getLwipPoolStats(p, pool)) continue;
+    if (!firstPool) client.print(',');
+    firstPool = false;
+    client.print(F("{\"name\":\""));
+    client.print(pool.name);
+    client.print(F("\",\"used\":"));
+    client.print(pool.used);
+    client.print(F(",\"max\":"));
+    client.print(pool.max);
+    client.print(F(",\"avail\":"));
+    client.print(pool.avail);
+    client.print(F(",\"err\":"));
+    client.print(pool.err);
+    client.print('}');
+  }
+  client.println(F("]}}"));
 }
 
 
@@ -1061,16 +1493,115 @@ void handleStatsPage() {
   client.println("<tr><th>Fader</th><th>Current</th><th>Min</th><th>Max</th><th>OSC Value</th></tr>");
   client.println("<tbody id='stats-body'><tr><td colspan='5'>Loading...</td></tr></tbody></table>");
 
+  client.println("</div>");
+
+  client.println("<div class='card'>");
+  client.println("<h2>OSC Processing</h2>");
+  client.println("<table><tbody id='osc-budget-body'><tr><td colspan='2'>Loading...</td></tr></tbody></table>");
+  client.println("</div>");
+
+  client.println("<div class='card'>");
+  client.println("<h2>OSC Receive</h2>");
+  client.println("<table><tbody id='osc-rx-body'><tr><td colspan='2'>Loading...</td></tr></tbody></table>");
+  client.println("</div>");
+
+  client.println("<div class='card'>");
+  client.println("<h2>Consoles</h2>");
+  client.println("<table><tr><th>Console</th><th>Sent</th><th>Received</th><th>Ignored</th><th>Last heard</th></tr>");
+  client.println("<tbody id='osc-dest-body'><tr><td colspan='5'>Loading...</td></tr></tbody></table>");
+  client.println("<p class='help' id='osc-dest-summary'></p>");
+  client.println("<p class='help' id='osc-tcp-summary'></p>");
+  client.println("</div>");
+
+  client.println("<div class='card'>");
+  client.println("<h2>LED Output</h2>");
+  client.println("<table><tbody id='led-body'><tr><td>Loading...</td></tr></tbody></table>");
+  client.println("<p class='help'>Both strips are sent together by DMA at a fixed frame rate. Render time is the CPU time per frame; it and the transfer must fit in the frame budget. Dark fades are dithered across frames, and settled dim colors too when enabled on the LED settings page.</p>");
+  client.println("<p class='help' id='sacn-summary'></p>");
+  client.println("</div>");
+
+  client.println("<div class='card'>");
+  client.println("<h2>Network Stack</h2>");
+  client.println("<table><tr><th>Pool</th><th>Used</th><th>Max</th><th>Size</th><th>Errors</th></tr>");
+  client.println("<tbody id='lwip-body'><tr><td colspan='5'>Loading...</td></tr></tbody></table>");
+  client.println("<p class='help' id='lwip-summary'></p>");
+  client.println("</div>");
+
+  client.println("<div class='card'>");
+  client.println("<h2>Console Link</h2>");
+  client.println("<table><tbody id='link-body'><tr><td colspan='2'>Loading...</td></tr></tbody></table>");
+  client.println("<p class='help' id='page-cache-summary'></p>");
+  client.println("<p class='help'>State follows the plugin's heartbeat. Round trip needs the pong reply and <em>Receive Command</em> on the console's receive OSC entry; the wing pings after a fader release or key press and every 30s. Faders hold while the link is lost.</p>");
   client.println("</div>");
   client.println("</div>");
   waitForWriteSpace(600);
   client.println(F("<script>"
     "const statsBody=document.getElementById('stats-body');"
+    "const budgetBody=document.getElementById('osc-budget-body');"
+    "function renderBudget(b){if(!b)return;"
+    "let rows=`<tr><td>Budget</td><td>${b.budgetUs} us / ${b.packetLimit} packets</td></tr>`"
+    "+`<tr><td>Last decision</td><td>${b.reason}</td></tr>`"
+    "+`<tr><td>OSC pass</td><td>${b.oscStageUs} us</td></tr>`"
+    "+`<tr><td>Rest of loop</td><td>${b.loopOtherUs} us</td></tr>`;"
+    "for(const k in b.decisions){rows+=`<tr><td>Decisions: ${k}</td><td>${b.decisions[k]}</td></tr>`;}"
+    "budgetBody.innerHTML=rows;}"
+    "const rxBody=document.getElementById('osc-rx-body');"
+    "function renderRx(r){if(!r)return;"
+    "let rows=`<tr><td>Received</td><td>${r.received}</td></tr>`;"
+    "for(const k in r.handled){rows+=`<tr><td>Handled: ${k}</td><td>${r.handled[k]}</td></tr>`;}"
+    "rows+=`<tr><td>Queue drops</td><td>${r.queueDrops}</td></tr>`"
+    "+`<tr><td>Oversize drops</td><td>${r.oversize}</td></tr>`"
+    "+`<tr><td>Color bundles coalesced / other page</td><td>${r.coalesced} / ${r.colorStale}</td></tr>`"
+    "+`<tr><td>Parse failures / malformed</td><td>${r.parseFailures} / ${r.malformed}</td></tr>`"
+    "+`<tr><td>Queue high-water</td><td>${r.highWater}</td></tr>`"
+    "+`<tr><td>Latency last / max</td><td>${r.latencyLastUs} us / ${r.latencyMaxUs} us</td></tr>`;"
+    "let prev=0;for(const b of r.latency){const label=b.le?`${prev}-${b.le} us`:`> ${prev} us`;"
+    "rows+=`<tr><td>Latency ${label}</td><td>${b.n}</td></tr>`;prev=b.le;}"
+    "rxBody.innerHTML=rows;}"
+    "const destBody=document.getElementById('osc-dest-body');"
+    "function renderDest(d){if(!d)return;const names=['Primary','Backup'];let rows='';"
+    "d.list.forEach((c,i)=>{if(!c.enabled)return;const tag=i===d.active?' (sync source)':'';"
+    "const heard=c.lastHeardMs<0?'never':`${(c.lastHeardMs/1000).toFixed(1)} s ago`;"
+    "rows+=`<tr><td>${names[i]} ${c.ip}${tag}</td><td>${c.sent} (${c.sendErrors} err)</td><td>${c.received}</td><td>${c.ignored}</td><td>${heard}</td></tr>`;});"
+    "destBody.innerHTML=rows;document.getElementById('osc-dest-summary').textContent=`Failovers: ${d.failovers}`;}"
+    "function renderTcp(t){const el=document.getElementById('osc-tcp-summary');if(!t||!t.enabled){el.textContent='Transport: UDP';return;}"
+    "el.textContent=(t.connected?`Transport: TCP connected to ${t.remote}`:`Transport: TCP not connected (retry in ${t.backoffMs} ms), using UDP`)"
+    "+` | connects ${t.connects}, failures ${t.connectFailures}, drops ${t.disconnects} | sent ${t.framesSent} msgs in ${t.batches} batches, received ${t.framesReceived}, overflows ${t.txOverflows}`;}"
+    "const linkBody=document.getElementById('link-body');"
+    "function renderLink(l){if(!l)return;"
+    "const heard=l.lastPongMs<0?'never':`${(l.lastPongMs/1000).toFixed(1)} s ago`;"
+    "linkBody.innerHTML=`<tr><td>State</td><td>${l.state}</td></tr>`"
+    "+`<tr><td>Round trip last / smoothed</td><td>${l.rttMs} ms / ${l.srttMs} ms</td></tr>`"
+    "+`<tr><td>Jitter</td><td>${l.jitterMs} ms</td></tr>`"
+    "+`<tr><td>Pings / pongs / late / other wing</td><td>${l.pings} / ${l.pongs} / ${l.late} / ${l.otherWing}</td></tr>`"
+    "+`<tr><td>Last pong</td><td>${heard}</td></tr>`"
+    "+`<tr><td>Times lost / resyncs requested</td><td>${l.lost} / ${l.resyncs}</td></tr>`"
+    "+`<tr><td>Update gaps / missed updates</td><td>${l.seqGaps} / ${l.missedUpdates}</td></tr>`"
+    "+`<tr><td>Stale fader echoes ignored</td><td>${l.faderEchoes}</td></tr>`"
+    "+`<tr><td>Key LED predictions / confirmed / reverted</td><td>${l.keyPredictions} / ${l.keyConfirmed} / ${l.keyReverted}</td></tr>`;"
+    "for(const k in l.resyncReasons){linkBody.innerHTML+=`<tr><td>Resync: ${k}</td><td>${l.resyncReasons[k]}</td></tr>`;}}"
+    "function renderPageCache(c){if(!c)return;"
+    "document.getElementById('page-cache-summary').textContent=`Page cache: ${c.entries} pages, ${c.hits} instant flips, ${c.misses} misses, ${c.corrections} corrected by console, ${c.evictions} evicted`;}"
+    "const ledBody=document.getElementById('led-body');"
+    "function renderLeds(l){if(!l)return;const budget=Math.round(1000000/l.rate);"
+    "ledBody.innerHTML=`<tr><td>Frame rate</td><td>${l.rate} Hz (budget ${budget} us, transfer ${l.transferUs} us)</td></tr>`+"
+    "`<tr><td>Render time</td><td>${l.renderUs} us (max ${l.renderMaxUs} us)</td></tr>`+"
+    "`<tr><td>Frames</td><td>${l.rendered} rendered, ${l.shown} sent, ${l.deferred} held (DMA busy)</td></tr>`+"
+    "`<tr><td>Dithered frames</td><td>${l.dithered}</td></tr>`;}"
+    "function renderSacn(s){const el=document.getElementById('sacn-summary');if(!s||!s.universe){el.textContent='sACN input: off';return;}"
+    "el.textContent=(s.live?`sACN input: universe ${s.universe} from ${s.source} (priority ${s.priority})`:`sACN input: universe ${s.universe}, no source`)"
+    "+` | ${s.packets} packets, ${s.ignored} ignored, ${s.outOfOrder} out of order, ${s.lowerPriority} outranked, ${s.sourceChanges} source changes, ${s.timeouts} timeouts`;}"
+    "const lwipBody=document.getElementById('lwip-body');"
+    "function renderLwip(s){if(!s)return;"
+    "let rows=`<tr><td>Heap (MEM_SIZE)</td><td>${s.heap.used}</td><td>${s.heap.max}</td><td>${s.heap.avail}</td><td>${s.heap.err}</td></tr>`;"
+    "for(const p of s.pools){rows+=`<tr><td>${p.name}</td><td>${p.used}</td><td>${p.max}</td><td>${p.avail}</td><td>${p.err}</td></tr>`;}"
+    "lwipBody.innerHTML=rows;"
+    "document.getElementById('lwip-summary').textContent=`UDP in ${s.udp.recv}, out ${s.udp.xmit}, dropped ${s.udp.drop}, no memory ${s.udp.memerr} | TCP in ${s.tcp.recv}, out ${s.tcp.xmit}, retransmits ${s.tcp.rexmit}, dropped ${s.tcp.drop}, no memory ${s.tcp.memerr} | link drops ${s.linkDrops}`;}"
     "function renderStats(data){if(!data||!data.faders)return;"
     "let rows='';"
     "for(let i=0;i<data.faders.length;i++){const f=data.faders[i];"
     "rows+=`<tr><td>Fader ${f.id}</td><td>${f.current}</td><td>${f.min}</td><td>${f.max}</td><td>${f.osc}</td></tr>`;}"
-    "statsBody.innerHTML=rows;}"
+    "statsBody.innerHTML=rows;renderBudget(data.oscBudget);renderRx(data.oscRx);renderDest(data.oscDest);renderTcp(data.oscTcp);renderLink(data.consoleLink);renderPageCache(data.pageCache);renderLeds(data.leds);renderSacn(data.sacn);renderLwip(data.lwip);}"
     "async function refreshStats(){try{const res=await fetch('/stats_data');if(!res.ok)return;const data=await res.json();renderStats(data);}catch(e){}}"
     "refreshStats();"
     "setInterval(refreshStats,500);"
@@ -1227,6 +1758,13 @@ void handleLEDSettingsPage() {
   waitForWriteSpace(800);
 
   client.print(F("> Show level bars instead of full fill</label><p class='help-text'>When enabled the fader lights up to match the position.</p></div>"
+                 "<div class='form-group'><label>Dim Colors</label><label style='display: inline-block; margin-top: 6px;'>"
+                 "<input type='checkbox' name='dd' value='on'"));
+  if (Fconfig.ditherDimColors) client.print(F(" checked"));
+
+  waitForWriteSpace(800);
+
+  client.print(F("> Dither settled dim colors</label><p class='help-text'>Keeps the hue of dim mixed colors on faders and keys. Those LEDs are redrawn every frame while enabled; fades are always dithered.</p></div>"
                  "<div class='divider'></div>"
                  "<h3 style='margin: 6px 0;'>Exec LEDs</h3>"
                  "<div class='form-group'><label>Off Level</label><input type='number' name='eb' value='"));
@@ -1255,7 +1793,58 @@ void handleLEDSettingsPage() {
   client.println(F("'></div><p class='help-text'>Static picker or RGB values (0-255).</p></div>"
                    "<button type='submit' class='btn btn-primary btn-block'>Save LED Settings</button>"
                    "</form></div></div>"));
-  
+
+  waitForWriteSpace(600);
+
+  client.print(F("<div class='card'><div class='card-header'><h2>Exec Key LED Map</h2></div><div class='card-body'>"
+                 "<form method='get' action='/save' onsubmit='return composeKeyMap()'>"
+                 "<p class='help-text'>First pixel and pixel count of each exec key on the key strip (0-"));
+  client.print(LED_STRIP_LENGTH - 1);
+  client.print(F(", up to "));
+  client.print(KEY_LED_MAX_PIXELS);
+  client.println(F(" pixels per key, 0 leaves the key dark).</p>"
+                   "<table><thead><tr><th>Key</th><th>Start</th><th>Pixels</th></tr></thead><tbody id='keyMapBody'></tbody></table>"
+                   "<p class='help-text' id='keyMapWarn' style='color: #ff9800;'></p>"
+                   "<input type='hidden' name='km' id='keyMapField'>"
+                   "<button type='submit' class='btn btn-primary btn-block'>Save Key LED Map</button>"
+                   "</form></div></div>"));
+
+  client.print(F("<script>const keyIds=["));
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+    if (i > 0) client.print(',');
+    client.print(EXECUTOR_IDS[i]);
+  }
+  client.print(F("];const keyMap=["));
+  for (int i = 0; i < NUM_EXECUTORS_TRACKED; i++) {
+    if (i > 0) client.print(',');
+    client.printf("[%u,%u]", keyLedMap.keys[i].start, keyLedMap.keys[i].count);
+  }
+  client.println(F("];</script>"));
+
+  waitForWriteSpace(800);
+
+  client.print(F("<div class='card'><div class='card-header'><h2>sACN Input</h2></div><div class='card-body'><form method='get' action='/save'>"
+                 "<div class='form-group'><label><input type='checkbox' name='sacn_en' value='on'"));
+  if (sacnConfig.enabled) client.print(F(" checked"));
+  client.print(F("> Drive LEDs from sACN (E1.31)</label><p class='help-text'>Listens on UDP 5568, unicast or multicast 239.255.x.y for the universe.</p></div>"
+                 "<div class='form-group'><label>Universe</label><input type='number' name='sacn_u' min='1' max='63999' value='"));
+  client.print(sacnConfig.universe);
+  client.print(F("'></div><div class='form-group'><label>Fader Address</label><input type='number' name='sacn_fa' min='0' max='"));
+  client.print(512 - SACN_FADER_CHANNELS + 1);
+  client.print(F("' value='"));
+  client.print(sacnConfig.faderAddress);
+  client.print(F("'><p class='help-text'>First of 30 channels: RGB for faders 201-210. 0 = faders not driven.</p></div>"
+                 "<div class='form-group'><label>Key Address</label><input type='number' name='sacn_ka' min='0' max='"));
+  client.print(512 - SACN_KEY_CHANNELS + 1);
+  client.print(F("' value='"));
+  client.print(sacnConfig.keyAddress);
+  client.print(F("'><p class='help-text'>First of 120 channels: RGB for keys 101-110, 201-210, 301-310, 401-410. 0 = keys not driven.</p></div>"
+                 "<div class='form-group'><label>Wing Priority</label><input type='number' name='sacn_pri' min='0' max='200' value='"));
+  client.print(sacnConfig.wingPriority);
+  client.println(F("'><p class='help-text'>sACN priority of the appearance colors (0-200). Senders above it take over, equal merges highest value per channel, below is ignored.</p></div>"
+                   "<button type='submit' class='btn btn-primary btn-block'>Save sACN Settings</button>"
+                   "</form></div></div>"));
+
   waitForWriteSpace(600);
   client.println(F("</div>")); // container
 
@@ -1274,6 +1863,22 @@ void handleLEDSettingsPage() {
                    "</script>"));
 
   waitForWriteSpace(800);
+
+  client.println(F("<script>"
+                   "function keyMapRows(){return keyIds.map((id,i)=>[id,parseInt(document.getElementById('ks'+i).value)||0,parseInt(document.getElementById('kc'+i).value)||0]);}"
+                   "function checkKeyMap(){const owner={};const clash=[];"
+                   "keyMapRows().forEach(r=>{for(let p=r[1];p<r[1]+r[2];p++){if(owner[p]&&clash.indexOf(owner[p]+'/'+r[0])<0)clash.push(owner[p]+'/'+r[0]);owner[p]=r[0];}});"
+                   "document.getElementById('keyMapWarn').textContent=clash.length?'Keys sharing pixels (the later key shows): '+clash.join(', '):'';}"
+                   "function composeKeyMap(){document.getElementById('keyMapField').value=keyMapRows().map(r=>r[1]+':'+r[2]).join(',');return true;}"
+                   "const kb=document.getElementById('keyMapBody');"
+                   "keyIds.forEach((id,i)=>{const tr=document.createElement('tr');"
+                   "tr.innerHTML='<td>'+id+'</td><td><input type=\"number\" class=\"channel-input\" id=\"ks'+i+'\" min=\"0\" value=\"'+keyMap[i][0]+'\"></td>'"
+                   "+'<td><input type=\"number\" class=\"channel-input\" id=\"kc'+i+'\" min=\"0\" value=\"'+keyMap[i][1]+'\"></td>';"
+                   "kb.appendChild(tr);});"
+                   "kb.addEventListener('input',checkKeyMap);checkKeyMap();"
+                   "</script>"));
+
+  waitForWriteSpace(800);
   
   sendFooter();
   client.println(F("</body></html>"));
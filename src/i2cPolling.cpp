@@ -11,6 +11,7 @@
 #include "EEPROMStorage.h"
 #include "NetworkOSC.h"
 #include "Keysend.h"
+#include "KeyLedControl.h"
 
 // There are a lot of safeguards here to handle noisy i2c lines so even the most EMI unfriendly build should behave well
 
@@ -318,8 +319,12 @@ void processKeypressData(uint8_t count, uint8_t address) {
         }
     }
 
-      sendKeyOSC(keyNumber, state);
+    sendKeyOSC(keyNumber, state);
 
+    // Light the key now rather than after the console round trip
+    if (state == 1) {
+      predictKeyPress(keyIndex);
+    }
   }
 }
 
@@ -32,6 +32,9 @@ void initializeFaders() {
     
     
     faders[i].lastSentOscValue = -1;
+    faders[i].echoPage = 0;
+    faders[i].echoConfirmSeq = 0;
+    faders[i].heldEchoValue = -1;
     
     // Initialize color
     faders[i].red = Fconfig.baseBrightness;
@@ -48,7 +51,11 @@ void initializeFaders() {
     faders[i].currentBrightness = Fconfig.baseBrightness;
     faders[i].targetBrightness = Fconfig.baseBrightness;
     faders[i].brightnessStartTime = 0;
+    faders[i].fadeDuration = 0;
+    faders[i].fadeRate = 0;
     faders[i].lastReportedBrightness = 0;
+    faders[i].scaledColorKey = 0;      // Black at brightness 0, matches scaledColor
+    faders[i].scaledColor = 0;
   
   }
 }
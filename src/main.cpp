@@ -19,6 +19,9 @@
 #include "OLED.h"
 #include "Keysend.h"
 #include "KeyLedControl.h"
+#include "OscTcp.h"
+#include "ConsoleLink.h"
+#include "SacnReceiver.h"
 
 using namespace qindesign::network;
 using qindesign::osc::LiteOSCParser;
@@ -73,6 +76,7 @@ void setup() {
 
   // Set up network connection
   setupNetwork();
+  setupSacn();
 
   displayIPAddress();
 
@@ -104,8 +108,20 @@ void loop() {
   // Handle I2C Polling for encoders keypresses and encoder key press
   handleI2c();
 
+  // Link changes, DHCP fallback and address updates
+  networkLoop();
+
+  // sACN multicast membership follows the address
+  sacnLoop();
+
   // Process queued OSC packets from UDP callback
   processOscQueue();
+
+  // OSC over TCP: reconnect, read frames into the queue, flush batched output
+  oscTcpLoop();
+
+  // Ping the console plugin, track round trip and link health
+  consoleLinkLoop();
   
     
   // Process touch changes 
@@ -121,9 +137,8 @@ void loop() {
     clearTouchError();
   }
   
-    // Update NeoPixels
-  updateNeoPixels();
-  updateKeyLeds();
+    // Update NeoPixels at LED_FRAME_RATE, both strips go out in one transfer
+  renderLedFrame();
 
   // Check for reboot from serial, used for uploading firmware without having to press physical button
   checkSerialForReboot();
@@ -136,6 +151,7 @@ void loop() {
 void displayIPAddress(){
   currentIP = Ethernet.localIP();
   display.showIPAddress(currentIP,netConfig.receivePort,netConfig.sendToIP,netConfig.sendPort);
+  displayConsoleLinkStatus();
 
 }
 